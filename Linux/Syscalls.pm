@@ -99,13 +99,17 @@ use Config;
 use Scalar::Util qw( looks_like_number blessed );
 
 use Fcntl qw( S_IFMT );
-use POSIX qw( EBADF EFAULT EINVAL ENOSYS floor uname );
+use POSIX qw( EACCES EBADF EFAULT EINVAL EIO ENOSYS ENXIO EPERM floor uname );
 # Avoid «use Errno qw( E... );» as it results in dup import warnings with perl -Wc
 
 use constant {
     zero_but_true => '0 but true',
 };
 
+# Per-syscall counters are compiled in only when PERL5_SYSCALL_STATS is set in
+# the environment when this module is loaded; see syscall_stats.
+use constant _SYSCALL_STATS => !!$ENV{PERL5_SYSCALL_STATS};
+
 BEGIN {
     # When in syntax-checking mode, check for clashes with the POSIX module,
     # which (unhelpfully) exports everything by default, including optional
@@ -117,13 +121,66 @@ BEGIN {
     POSIX->import() if $^C;
 }
 
+package Linux::Syscalls::bless::cachestat       { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
 package Linux::Syscalls::bless::dirent          { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
 package Linux::Syscalls::bless::fiemap_extent   { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
+package Linux::Syscalls::bless::mmap            { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
+package Linux::Syscalls::bless::proc_stat       { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
+package Linux::Syscalls::bless::signalfd_siginfo { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
 package Linux::Syscalls::bless::stat            { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
 package Linux::Syscalls::bless::stat::mutable   { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
 package Linux::Syscalls::bless::statfs          { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
 package Linux::Syscalls::ioctl                  { BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ } }
 
+################################################################################
+#
+# Optional per-syscall instrumentation.
+#
+# When _SYSCALL_STATS is true, the "syscall" builtin is overridden in each
+# package in this file that uses it, so that every call is counted and timed
+# under the name it was looked up by (see _get_syscall_id), and failures are
+# tallied by errno. Otherwise nothing is installed, every wrapper compiles to
+# the builtin, and there is no cost at all.
+#
+# An override only takes effect if it's imported (assigned to the glob from
+# another package) before the calls are compiled, hence this comes first.
+
+package Linux::Syscalls::stats {
+    BEGIN { $INC{(__PACKAGE__ =~ s#::#/#gr).'.pm'} = __FILE__ }
+
+    our %name_of;       # syscall number → name
+    our %calls;         # name → count
+    our %ns;            # name → total elapsed nanoseconds
+    our %errors;        # name → { errno → count }
+
+    sub counted_syscall($@) {
+        my $id = shift;
+        my $t0 = Time::HiRes::clock_gettime(Time::HiRes::CLOCK_MONOTONIC());
+        my $r = CORE::syscall $id, @_;
+        my $e = $! + 0;
+        my $t1 = Time::HiRes::clock_gettime(Time::HiRes::CLOCK_MONOTONIC());
+        my $name = $name_of{$id} // "syscall_$id";
+        ++$calls{$name};
+        $ns{$name} += ($t1 - $t0) * 1e9;
+        ++$errors{$name}{$e} if $r == -1;
+        $! = $e;
+        return $r;
+    }
+
+    BEGIN {
+        if (Linux::Syscalls::_SYSCALL_STATS) {
+            require Time::HiRes;
+            no strict 'refs';
+            *{$_.'::syscall'} = \&counted_syscall for qw( Linux::Syscalls Linux::Syscalls::ticker );
+        }
+    }
+
+    END {
+        print STDERR Linux::Syscalls::syscall_report()
+            if Linux::Syscalls::_SYSCALL_STATS && $ENV{PERL5_SYSCALL_STATS} eq 'report';
+    }
+}
+
 ################################################################################
 #
 # Fetch a constant without deoptimizing it.
@@ -431,6 +488,35 @@ sub _timespec_to_seconds($$) {
     goto &$f;
 }
 
+#
+# Floating point is no good for exact comparisons (such as detecting changed
+# mtimes), so the stat & rusage unpackers accept an optional time format:
+#
+#   TIME_SECONDS - seconds, via _timespec_to_seconds (the default)
+#   TIME_NS      - integer nanoseconds, as a Time::Nanosecond::ns when that's
+#                  been loaded, otherwise as a plain integer
+#   TIME_PAIR    - [ seconds, nanoseconds ]
+#
+# Each timestamp remains a single element, so the positions in the returned
+# list don't change.
+#
+
+use constant {
+    TIME_SECONDS    =>  0,
+    TIME_NS         =>  1,
+    TIME_PAIR       =>  2,
+};
+
+_export_tag qw{ time_ => TIME_SECONDS TIME_NS TIME_PAIR };
+
+sub _timespec_as($$$) {
+    my ($format, $s, $ns) = @_;
+    return _timespec_to_seconds $s, $ns if ! $format;
+    return [ $s, $ns ] if $format == TIME_PAIR;
+    return Time::Nanosecond::ns->from_timespec($s, $ns) if exists &Time::Nanosecond::ns::from_timespec;
+    return $s * 1_000_000_000 + $ns;
+}
+
 #
 # Standardized argument handling:
 #
@@ -456,9 +542,10 @@ sub _map_fd(\$;$) {
     my ($dir_fd, $allow_at_cwd) = @_;
     my $D = $$dir_fd;
     if ( ref $D ) {
-        # Try calling fileno method on any object that implements it
-        eval { $$dir_fd = $D->dirfd;  1 } and return 1 if $^V ge v5.25.0;
-        eval { $$dir_fd = $D->fileno; 1 } and return 1;
+        # Try calling fileno method on any object that implements it (a
+        # closed handle returns undef, which must not become fd 0)
+        eval { defined( $$dir_fd = $D->dirfd  ) } and return 1 if $^V ge v5.25.0;
+        eval { defined( $$dir_fd = $D->fileno ) } and return 1;
         # Fall through and use fileno builtin
     } else {
         # Keep the input value unchanged if it's an integer, including
@@ -541,7 +628,12 @@ UNITCHECK {
     push @try, $running_on_hw || ();
     push @try, 'mips_o32' if $running_on_hw eq 'mipsel';
 
+    # Each file that loads replaces %syscall_map outright, so the most
+    # specific one wins; but %pack_map entries accumulate, so that the generic
+    # layouts serve as defaults for anything an arch file doesn't mention.
     my @e;
+    my %packs;
+    my $loaded = 0;
     for my $mm ( do { my %seen; grep { defined && ! $seen{$_}++ } @try } ) {
         my $m = "${built_for_os}::Syscalls::$mm";
         eval q{
@@ -551,12 +643,17 @@ UNITCHECK {
         } . qq{
             warn "\e[2m  Loaded $m\e[22m\n" if $^C || $^W;
             1;
-        } and last;
-        push @e, $@;
-        warn "Failed to load $m; $@" if $^C || $^W;
+        } or do {
+            push @e, $@;
+            warn "Failed to load $m; $@" if $^C || $^W;
+            next;
+        };
+        %packs = ( %packs, %pack_map );
+        ++$loaded;
     }
     no diagnostics;
-    @e and die "@e\n";
+    $loaded or die "@e\n";
+    %pack_map = %packs;
 }
 
 sub _get_syscall_id($;$) {
@@ -569,6 +666,7 @@ sub _get_syscall_id($;$) {
         if (exists &$func) {
             #goto &$func;
             my $r = &$func();
+            $Linux::Syscalls::stats::name_of{$r} //= $name if _SYSCALL_STATS;
             warn sprintf "syscall number for %s is %d\n", $name, $r if ($^C || $^W) && ! $quiet;
             return $r;
         }
@@ -576,6 +674,7 @@ sub _get_syscall_id($;$) {
     }
 
     my $s = $syscall_map{$name};
+    $Linux::Syscalls::stats::name_of{$s} //= $name if _SYSCALL_STATS && defined $s;
     $s // do {
         warn "Syscall $name not known for @{[$running_on_os // ()]} / @{[$running_on_hw // ()]}\n" if ! $quiet;
      ## use Data::Dumper;
@@ -1135,7 +1234,7 @@ sub linkat($$$$;$) {
 #                                                                                                                                                                 #                       x86_64_x32  <sys/stat.h>                        +_LARGEFILE64_SOURCE=1  *+__USE_LARGEFILE64=1  *-__USE_LARGEFILE  -_STAT_VER_LINUX_OLD    +_STAT_VER_KERNEL=0, -_STAT_VER_SVR4,   +_STAT_VER_LINUX=1; COMPILED gcc -mx32 -DUSE_x32 -D_LARGEFILE64_SOURCE
 
 sub _unpack_stat {
-    my ($buffer) = @_;
+    my ($buffer, $time_format) = @_;
 
     my $time_resolution = TIMERES_SECOND;
 
@@ -1178,9 +1277,9 @@ sub _unpack_stat {
          $size, $blksize, $blocks,
          $atime, $atime_ns, $mtime, $mtime_ns, $ctime, $ctime_ns ) = unpack $unpack_fmt, $buffer;
 
-    $atime = _timespec_to_seconds $atime, $atime_ns;
-    $mtime = _timespec_to_seconds $mtime, $mtime_ns;
-    $ctime = _timespec_to_seconds $ctime, $ctime_ns;
+    $atime = _timespec_as $time_format, $atime, $atime_ns;
+    $mtime = _timespec_as $time_format, $mtime, $mtime_ns;
+    $ctime = _timespec_as $time_format, $ctime, $ctime_ns;
 
     return  $dev, $ino, $mode, $nlink, $uid, $gid, $rdev, $size,
             $atime, $mtime, $ctime,
@@ -1344,33 +1443,33 @@ package Linux::Syscalls::bless::stat::mutable {
 }
 
 _export_ok qw{ statns };
-sub statns($) {
-    my ($path) = @_;
+sub statns($;$) {
+    my ($path, $time_format) = @_;
     _normalize_path $path;
     my $buffer = "\xa5" x 160;
     state $syscall_id = _get_syscall_id 'stat';
     0 == syscall $syscall_id, $path, $buffer or return;
-    return _unpack_stat($buffer);
+    return _unpack_stat($buffer, $time_format);
 }
 
 _export_ok qw{ lstatns };
-sub lstatns($) {
-    my ($path) = @_;
+sub lstatns($;$) {
+    my ($path, $time_format) = @_;
     _normalize_path $path;
     my $buffer = "\xa5" x 160;
     state $syscall_id = _get_syscall_id 'lstat';
     0 == syscall $syscall_id, $path, $buffer or return;
-    return _unpack_stat($buffer);
+    return _unpack_stat($buffer, $time_format);
 }
 
 _export_ok qw{ fstatns };
-sub fstatns($) {
-    my ($fd) = @_;
+sub fstatns($;$) {
+    my ($fd, $time_format) = @_;
     _map_fd($fd);
     my $buffer = "\xa5" x 160;
     state $syscall_id = _get_syscall_id 'fstat';
     0 == syscall $syscall_id, $fd, $buffer or return;
-    return _unpack_stat($buffer);
+    return _unpack_stat($buffer, $time_format);
 }
 
 BEGIN {
@@ -1388,14 +1487,14 @@ BEGIN {
 *statat = \&fstatat;
 \&statat or die; # suppress "only used once" warning
 _export_tag qw{ _at => fstatat statat };
-sub fstatat($$;$) {
-    my ($dir_fd, $path, $flags) = @_;
+sub fstatat($$;$$) {
+    my ($dir_fd, $path, $flags, $time_format) = @_;
     _resolve_dir_fd_path $dir_fd, $path, $flags or return;
     my $buffer = "\xa5" x 160;
     state $syscall_id = _get_syscall_id 'newfstatat';
     my $r = syscall $syscall_id, $dir_fd, $path, $buffer, $flags;
     0 == $r or return;
-    return _unpack_stat($buffer);
+    return _unpack_stat($buffer, $time_format);
 }
 
 ################################################################################
@@ -2056,7 +2155,7 @@ sub getdents($;$$) {
     $bufsize ||= getdents_default_bufsize;
     $options //= GDE_DEFAULT;
 
-    state $syscall_id = _get_syscall_id 'getdents';
+    state $syscall_id = _get_syscall_id 'getdents64';
     FETCH: for (;;) {
         $bufsize <= getdents_maximum_bufsize or $bufsize = getdents_maximum_bufsize;
         my $buffer = "\xee" x $bufsize;
@@ -2084,9 +2183,12 @@ sub getdents($;$$) {
             # The new getdents64 always returns d_inode, d_next, d_reclen, d_type,
             # and d_name (null-terminated) in that order on all architectures.
             #
-            my ($inode, $next, $entsize, $type, $name) = unpack '@'.$offset.'QQSCU0Z*', $buffer;
+            # (Unpack the name separately from just this entry, as a U0 that
+            # applies to the whole buffer makes each unpack O(bufsize).)
+            my ($inode, $next, $entsize, $type) = unpack '@'.$offset.'QQSC', $buffer;
             $entsize or last UNPACK;    # can't get anything more out of this block
-            $entsize < 0 || $entsize > $res_size - $offset and $! = EFAULT, return undef;  # error while unpacking
+            $entsize < 19 || $entsize > $res_size - $offset and $! = EFAULT, return undef;  # error while unpacking
+            my $name = unpack 'U0Z*', substr $buffer, $offset + 19, $entsize - 19;
             push @r, bless [$name, $inode, $type, $next], Linux::Syscalls::bless::dirent::
                 unless $options & GDE_SKIP_WHITEOUT && $type == DT_WHT
                     || $options & GDE_SKIP_DOTDOTDOT && ( $name eq '.' || $name eq '..' );
@@ -2302,9 +2404,13 @@ sub fiemap($;$$) {
     my $buffer = pack( $packfmt, $fm_start, $fm_length, $in_flags, 0xeeeeeeee, $bufcount ) . (  "\xee" x ( $bufcount * fiemap_extent_size ) );
     my $res = ioctl $fd, FS_IOC_FIEMAP, $buffer;
     #my $res = syscall $syscall_id, $fd, $buffer;
-    _map_fd($fd);
-    printf STDERR "ioctl(%d, FS_IOC_FIEMAP, [%s]) -> %s\n", $fd, unpack("H*",$buffer), $res // '(undef)';
-    $res >= 0 or return;
+    state $debug_fiemap = $ENV{PERL5_DEBUG_FIEMAP};
+    if ($^C || $debug_fiemap) {
+        my $n = $fd;
+        _map_fd($n);
+        printf STDERR "ioctl(%d, FS_IOC_FIEMAP, [%s]) -> %s\n", $n, unpack("H*",$buffer), $res // '(undef)';
+    }
+    defined $res or return;
     my (undef, undef, $out_flags, $fm_mapped_extents ) = unpack fiemap_header_packfmt, $buffer;
     my @r = map {
             bless [ unpack fiemap_extent_packfmt,
@@ -2316,9 +2422,90 @@ sub fiemap($;$$) {
     return $out_flags, \@r;
 }
 
+# fiemap_read - read the contents of a set of files in ascending order of the
+# physical location of their extents, so that a rotating disk (or anything else
+# with expensive seeks) is swept in one direction rather than thrashed.
+#
+#   fiemap_read @files, \&callback, $chunk_size, $fiemap_flags
+#
+# Each file may be a path or an open filehandle. The callback is invoked as
+#
+#   $callback->($file, $logical_offset, $data)
+#
+# where $file is the entry from @files; return false from it to abort the scan.
+# Chunks for any one file are not necessarily delivered in logical order.
+# Holes and unwritten extents (which read as zeroes) are not delivered at all,
+# so a caller reassembling the file should pre-size it with truncate.
+#
+# Extents whose location is unknown (delayed allocation, or a filesystem that
+# doesn't support fiemap at all) are read last, after all the mapped extents.
+#
+# Returns the number of bytes delivered, or empty (with $! set) on failure.
+
+use constant fiemap_read_chunk_size => 1 << 20;
+
+sub _fiemap_all($$) {
+    my ($fh, $in_flags) = @_;
+    my $bufcount = 64;
+    for (;;) {
+        my ($out_flags, $extents) = fiemap $fh, $bufcount, $in_flags or return;
+        return $extents if @$extents < $bufcount || ! ($out_flags & FIEMAP_FLAG_PARTIAL);
+        $bufcount *= 2;
+    }
+}
+
+sub fiemap_read(\@$;$$) {
+    my ($files, $callback, $chunk_size, $in_flags) = @_;
+    $chunk_size ||= fiemap_read_chunk_size;
+    $in_flags //= 0;
+
+    my @fh;
+    my @extents;
+    for my $i (0 .. $#$files) {
+        my $fh = $files->[$i];
+        unless ( ref $fh || ref \$fh eq 'GLOB' ) {
+            undef $fh;
+            open $fh, '<:raw', $files->[$i] or return;
+        }
+        $fh[$i] = $fh;
+        if ( my $x = _fiemap_all $fh, $in_flags ) {
+            for my $e (@$x) {
+                my $f = $e->flags;
+                next if $f & FIEMAP_EXTENT_UNWRITTEN;
+                push @extents, [ $f & FIEMAP_EXTENT_UNKNOWN ? FIEMAP_MAX_OFFSET : $e->physical,
+                                 $i, $e->logical, $e->length ];
+            }
+        } else {
+            # No mapping available; read the whole file after everything else.
+            push @extents, [ FIEMAP_MAX_OFFSET, $i, 0, FIEMAP_MAX_OFFSET ];
+        }
+    }
+
+    @extents = sort {    $a->[0] <=> $b->[0]
+                      || $a->[1] <=> $b->[1]
+                      || $a->[2] <=> $b->[2] } @extents;
+
+    my $total = 0;
+    EXTENT: for my $x (@extents) {
+        my (undef, $i, $offset, $length) = @$x;
+        my $fh = $fh[$i];
+        defined sysseek $fh, $offset, 0 or return;
+        while ($length > 0) {
+            my $n = sysread $fh, my $data, $length < $chunk_size ? $length : $chunk_size;
+            defined $n or return;
+            $n or next EXTENT;  # extents may extend beyond EOF
+            $callback->($files->[$i], $offset, $data) or last EXTENT;
+            $total += $n;
+            $offset += $n;
+            $length -= $n;
+        }
+    }
+    return $total || zero_but_true;
+}
+
 _export_tag qw( fiemap =>
 
-    fiemap
+    fiemap fiemap_read
 
     FIEMAP_FLAG_SYNC FIEMAP_FLAG_XATTR FIEMAP_FLAGS_COMPAT FIEMAP_FLAG_CACHE
 
@@ -2343,162 +2530,958 @@ if ($^C) {
 ################################################################################
 
 #
-# Emulate a hangup on this process's controlling terminal, which should result
-# in all processes in this session being sent SIGHUP when they attempt to
-# interact with the terminal.
+# pread, pwrite, ftruncate - positioned I/O on filedescriptors
+#
+# Any of these can take either a numeric filedescriptor or a Perl filehandle;
+# pread and pwrite do not affect (nor are they affected by) the file position.
+#
+# pread returns the data read (an empty string at EOF); pwrite returns the
+# number of bytes written. On 32-bit ABIs the 64-bit offset is split across a
+# register pair; that is only done for ia32, and elsewhere they fail with
+# ENOSYS.
+#
+# (POSIX already provides lseek, SEEK_SET, SEEK_CUR & SEEK_END, but its lseek
+# only takes numeric filedescriptors, and it lacks SEEK_DATA & SEEK_HOLE.)
 #
 
-_export_ok 'vhangup';
+use constant {
+    SEEK_DATA   => 3,   # next offset >= given offset that holds data
+    SEEK_HOLE   => 4,   # next offset >= given offset that's in a hole (or EOF)
+};
 
-sub vhangup() {
-    state $syscall_id = _get_syscall_id 'vhangup';
-    return 0 == syscall $syscall_id;
+sub _lseek($$$) {
+    my ($fd, $offset, $whence) = @_;
+    _map_fd($fd) or return;
+    state $syscall_id = _get_syscall_id 'lseek';
+    my $r = syscall $syscall_id, $fd, $offset+0, $whence+0;
+    return if $r < 0;
+    return $r || zero_but_true;
 }
 
-################################################################################
+# A 64-bit file offset (loff_t) is passed as one register where a long is 64
+# bits wide, but as a pair of registers on 32-bit ABIs. Only the ia32 layout
+# (low word first, with no alignment padding) is handled; other 32-bit ABIs
+# get ENOSYS rather than a silently misplaced offset.
+sub _loff_args($) {
+    my ($offset) = @_;
+    return $offset+0 if $Config{longsize} >= 8;
+    if ( $built_for_hw ne 'ia32' ) {
+        $! = ENOSYS;
+        return;
+    }
+    return $offset % 2**32, int( $offset / 2**32 );
+}
+
+# The size of an open file, taken with fstat so that (unlike seeking to the
+# end) the file position is left alone.
+sub _fd_size($) {
+    my ($fd) = @_;
+    my @st = fstatns $fd or return;
+    return $st[7] || zero_but_true;
+}
+
+sub pread($$$) {
+    my ($fd, $count, $offset) = @_;
+    _map_fd($fd) or return;
+    my @offset = _loff_args $offset or return;
+    state $syscall_id = _get_syscall_id 'pread64';
+    my $buffer = "\0" x $count;
+    my $r = syscall $syscall_id, $fd, $buffer, $count+0, @offset;
+    return if $r < 0;
+    substr($buffer, $r) = '';
+    return $buffer;
+}
+
+sub pwrite($$$) {
+    my ($fd, $buffer, $offset) = @_;
+    _map_fd($fd) or return;
+    my @offset = _loff_args $offset or return;
+    state $syscall_id = _get_syscall_id 'pwrite64';
+    my $r = syscall $syscall_id, $fd, $buffer, length $buffer, @offset;
+    return if $r < 0;
+    return $r || zero_but_true;
+}
+
+sub ftruncate($$) {
+    my ($fd, $length) = @_;
+    _map_fd($fd) or return;
+    state $syscall_id = _get_syscall_id 'ftruncate';
+    my $r = syscall $syscall_id, $fd, $length+0;
+    return if $r < 0;
+    return 1;
+}
+
+_export_tag qw{ pio => pread pwrite };
 
 #
-# Exit
+# data_regions - iterate over the regions of a file that hold data, skipping
+# holes, using lseek with SEEK_DATA and SEEK_HOLE. This is much cheaper than
+# fiemap when all that's wanted is the data/hole layout.
 #
-# Invoke the exit syscall directly, with no cleanup.
-# This may allow a process to return an exit status wider than 8 bits.
+#   my $it = data_regions $fd, $start;
+#   while ( my ($offset, $length) = $it->() ) { ... }
+#
+# The iterator returns empty at the end of the file (with $! zero), or on
+# error (with $! set). Note that it moves the file position of $fd.
+#
+# Filesystems without native support treat the whole file as one data region.
 #
 
-_export_tag qw{ proc => Exit };
-sub Exit($) {
-    my ($status) = @_;
-    state $syscall_id = _get_syscall_id 'exit_group';
-    return 0 == syscall $syscall_id, $status;
+sub data_regions($;$) {
+    my ($fd, $pos) = @_;
+    _map_fd($fd) or return;
+    $pos //= 0;
+    return sub {
+        defined $pos or return;
+        my $data = _lseek $fd, $pos, SEEK_DATA;
+        my $hole = $data && _lseek $fd, $data, SEEK_HOLE;
+        if ( ! $hole ) {
+            undef $pos;
+            $! = 0 if $! == ENXIO;  # no data beyond $pos
+            return;
+        }
+        $pos = $hole;
+        return $data + 0, $hole - $data;
+    };
 }
 
 #
-# pidfd
-#
-
-_export_tag qw{ proc pidfs => pidfd_open };
-sub pidfd_open($) {
-    my ($pid) = @_;
-    state $syscall_id = _get_syscall_id 'pidfd_open';
-    my $ret = syscall $syscall_id, $pid;
-    return if $ret < 0;
-    return $ret;
+# copy_sparse - copy the contents of one file to another, preserving holes.
+#
+#   copy_sparse $in_fd, $out_fd, $chunk_size
+#
+# Only the data regions of the input are read and written; the output is then
+# truncated (or extended) to the length of the input, so any holes in the input
+# become holes in the output (provided the output starts out empty).
+#
+# Returns the number of bytes copied (excluding holes). On success the file
+# position of $in_fd is left where it was (data_regions moves it while copying).
+#
+
+use constant copy_sparse_chunk_size => 1 << 20;
+
+sub copy_sparse($$;$) {
+    my ($in_fd, $out_fd, $chunk_size) = @_;
+    _map_fd($in_fd) or return;
+    _map_fd($out_fd) or return;
+    $chunk_size ||= copy_sparse_chunk_size;
+    my $pos = _lseek $in_fd, 0, POSIX::SEEK_CUR or return;
+    my $it = data_regions $in_fd or return;
+    my $total = 0;
+    while ( my ($offset, $length) = $it->() ) {
+        while ($length > 0) {
+            my $buffer = pread $in_fd, $length < $chunk_size ? $length : $chunk_size, $offset;
+            defined $buffer or return;
+            my $n = length $buffer or last;  # file shrank underneath us
+            for (my $w = 0 ; $w < $n ;) {
+                my $r = pwrite $out_fd, substr($buffer, $w), $offset + $w or return;
+                if ( $r == 0 ) {
+                    $! = EIO;
+                    return;
+                }
+                $w += $r;
+            }
+            $total += $n;
+            $offset += $n;
+            $length -= $n;
+        }
+    }
+    $! and return;
+    my $size = _fd_size $in_fd or return;
+    ftruncate $out_fd, $size or return;
+    _lseek $in_fd, $pos, POSIX::SEEK_SET or return;
+    return $total || zero_but_true;
 }
 
+_export_tag qw{ seek =>
+    SEEK_DATA SEEK_HOLE
+    data_regions copy_sparse ftruncate
+};
+
+################################################################################
+
 #
-# waitid
+# mmap, munmap, mremap, madvise, msync - memory mappings
 #
-# Implement the POSIX waitid call and the Linux-specific extension
-# (which takes an additional parameter that has a struct times to
-# record the time usage of any reaped processses). This extension
-# does not have any official name, so I simply call it "waitid5",
-# since the syscall takes 5 parameters, analoguously to wait3 & wait4.
+#   my $m = mmap $addr, $length, $prot, $flags, $fd, $offset;
 #
-# Note that unlike the C version, values are returned, rather than
-# modifying parameters through pointers.
+# Pass undef for $fd to get an anonymous mapping (MAP_ANONYMOUS is implied).
+# Returns a Linux::Syscalls::bless::mmap object, which unmaps itself when the
+# last reference to it goes away.
+#
+# Pure Perl cannot make a scalar whose string buffer *is* the mapping, so the
+# contents are accessed through windows: $m->peek($offset, $length) copies out
+# just the bytes asked for (using unpack "P"), and $m->poke($offset, $data)
+# writes in place (using process_vm_writev on ourself, falling back to
+# /proc/self/mem). For scanning large files that's still a big saving over
+# reading the whole thing into a Perl string, and the page cache is shared
+# rather than duplicated.
+#
+# munmap, mremap, madvise & msync take raw addresses (or an mmap object in
+# place of the address & length).
 #
 
-BEGIN {
-my %w_const = (
+use constant {
+    PROT_NONE           => 0x0,
+    PROT_READ           => 0x1,
+    PROT_WRITE          => 0x2,
+    PROT_EXEC           => 0x4,
+
+    MAP_SHARED          => 0x01,
+    MAP_PRIVATE         => 0x02,
+    MAP_SHARED_VALIDATE => 0x03,
+    MAP_FIXED           => 0x10,
+    MAP_FIXED_NOREPLACE => 0x100000,
+};
 
-    # Values taken from /usr/include/asm-generic/siginfo.h
-    CLD_EXITED      =>  1, #   Child has exited.
-    CLD_KILLED      =>  2, #   Child was killed.
-    CLD_DUMPED      =>  3, #   Child was killed and dumped core.
-    CLD_TRAPPED     =>  4, #   Traced child has trapped (for debugging).
-    CLD_STOPPED     =>  5, #   Child has stopped (and can be resumed).
-    CLD_CONTINUED   =>  6, #   Stopped child has continued.
+use constant $Config{archname} =~ /^mips/ ? {
+    MAP_NORESERVE       => 0x0400,
+    MAP_ANONYMOUS       => 0x0800,
+    MAP_LOCKED          => 0x8000,
+    MAP_POPULATE        => 0x10000,
+    MAP_HUGETLB         => 0x80000,
+} : {
+    MAP_ANONYMOUS       => 0x20,
+    MAP_LOCKED          => 0x2000,
+    MAP_NORESERVE       => 0x4000,
+    MAP_POPULATE        => 0x8000,
+    MAP_HUGETLB         => 0x40000,
+};
 
-    # Values taken from /usr/include/linux/wait.h
-    WNOHANG         =>  0x00000001,
-    WUNTRACED       =>  0x00000002, # alias for WSTOPPED
-    WSTOPPED        =>  0x00000002, #WUNTRACED
-    WEXITED         =>  0x00000004,
-    WCONTINUED      =>  0x00000008,
-    WNOWAIT         =>  0x01000000, # Don't reap, just poll status.
-    WNOTHREAD       =>  0x20000000, # (__WNOTHREAD) Don't wait on children of other threads in this group
-    WALLCHILDREN    =>  0x40000000, # (__WALL) Wait on all children, regardless of type
-    WCLONE          =>  0x80000000, # (__WCLONE) Wait only on non-SIGCHLD children
+use constant {
+    MAP_FAILED          => -1,
+
+    MADV_NORMAL         => 0,   # no special treatment
+    MADV_RANDOM         => 1,   # expect random page references
+    MADV_SEQUENTIAL     => 2,   # expect sequential page references
+    MADV_WILLNEED       => 3,   # will need these pages
+    MADV_DONTNEED       => 4,   # don't need these pages
+    MADV_FREE           => 8,   # free pages only if memory pressure
+    MADV_REMOVE         => 9,   # remove these pages & resources
+    MADV_DONTFORK       => 10,  # don't inherit across fork
+    MADV_DOFORK         => 11,  # do inherit across fork
+    MADV_MERGEABLE      => 12,  # KSM may merge identical pages
+    MADV_UNMERGEABLE    => 13,  # KSM may not merge identical pages
+    MADV_HUGEPAGE       => 14,  # worth backing with hugepages
+    MADV_NOHUGEPAGE     => 15,  # not worth backing with hugepages
+    MADV_DONTDUMP       => 16,  # exclude from core dump
+    MADV_DODUMP         => 17,  # clear the MADV_DONTDUMP flag
+    MADV_COLD           => 20,  # deactivate these pages
+    MADV_PAGEOUT        => 21,  # reclaim these pages
+    MADV_POPULATE_READ  => 22,  # populate (prefault) page tables readable
+    MADV_POPULATE_WRITE => 23,  # populate (prefault) page tables writable
+
+    MS_ASYNC            => 1,   # sync memory asynchronously
+    MS_INVALIDATE       => 2,   # invalidate the caches
+    MS_SYNC             => 4,   # synchronous memory sync
+
+    MREMAP_MAYMOVE      => 1,
+    MREMAP_FIXED        => 2,
+    MREMAP_DONTUNMAP    => 4,
+};
 
-    # Values taken from /usr/include/bits/waitflags.h
-    P_ALL           =>  0,          # Any child (ignoring ID)
-    P_PID           =>  1,          # A specific child by PID
-    P_PGID          =>  2,          # Any child within a process group, by PGID
-    P_PIDFD         =>  3,          # Child identified by filedescriptor
+use constant _ptr_packfmt => $Config{ptrsize} == 8 ? 'Q' : 'L';
+use constant _page_size   => POSIX::sysconf(POSIX::_SC_PAGESIZE()) || 4096;
 
-);
-    for my $k (keys %w_const) {
-        # empty list indicates that the constant is not defined; a singleton
-        # indicates defined value; a pair indicates an error...
-        my @ov = _get_scalar_constant $k or next;
-        @ov == 1 or die "Symbol $k already defined with a $ov[1] value!\n";
-        # constant $k already exists (probably from POSIX) so delete it from
-        # the list that we're about to add.
-        my $nv = delete $w_const{$k};
-        # But verify that we would provide the same numeric value.
-        $ov[0] == $nv or
-            die "Symbol $k already has value $ov[0], which disagrees our value $nv\n";
-        warn "Already have $k (probably from POSIX)\n" if $^C && $^W;
+sub _addr_len(\@) {
+    my ($a) = @_;
+    splice @$a, 0, 1, $a->[0]->addr, $a->[0]->length if blessed $a->[0];
+    return 1;
+}
+
+sub mmap($$$$;$$) {
+    my ($addr, $length, $prot, $flags, $fd, $offset) = @_;
+    if (defined $fd) {
+        _map_fd($fd) or return;
+    } else {
+        $fd = -1;
+        $flags |= MAP_ANONYMOUS;
     }
-    constant->import(\%w_const);
-};
+    $offset //= 0;
+    # Where there's an mmap2 (32-bit ABIs), it takes the offset in 4096-byte
+    # units, and plain mmap may be the old one-struct-pointer form.
+    state $mmap2_id = _get_syscall_id 'mmap2', 1;
+    state $syscall_id = $mmap2_id // _get_syscall_id 'mmap';
+    if ( defined $mmap2_id ) {
+        if ( $offset % 4096 ) {
+            $! = EINVAL;
+            return;
+        }
+        $offset /= 4096;
+    }
+    my $r = syscall $syscall_id, ($addr // 0)+0, $length+0, $prot+0, $flags+0, $fd+0, $offset+0;
+    return if $r == MAP_FAILED;
+    return bless [ $r, $length+0, $prot, $flags ], Linux::Syscalls::bless::mmap::;
+}
 
-_export_tag qw{ proc si_codes =>
-                    CLD_EXITED
-                    CLD_KILLED
-                    CLD_DUMPED
-                    CLD_TRAPPED
-                    CLD_STOPPED
-                    CLD_CONTINUED };
+sub munmap($;$) {
+    # Let an mmap object forget its address, lest DESTROY unmap it a second
+    # time (by when something else may have been mapped there)
+    return $_[0]->munmap if blessed $_[0] && $_[0]->isa(Linux::Syscalls::bless::mmap::);
+    _addr_len @_;
+    my ($addr, $length) = @_;
+    state $syscall_id = _get_syscall_id 'munmap';
+    my $r = syscall $syscall_id, $addr+0, $length+0;
+    return if $r < 0;
+    return 1;
+}
 
-_export_tag qw{ proc wait_id_types =>
-                    P_ALL
-                    P_PID
-                    P_PGID
-                    P_PIDFD };
+sub mremap($$$;$$) {
+    my ($old_addr, $old_size, $new_size, $flags, $new_addr) = @_;
+    state $syscall_id = _get_syscall_id 'mremap';
+    my $r = syscall $syscall_id, $old_addr+0, $old_size+0, $new_size+0, ($flags // 0)+0, ($new_addr // 0)+0;
+    return if $r == MAP_FAILED;
+    return $r;
+}
 
-_export_tag qw{ proc wait_options =>
-                    WNOHANG
-                    WUNTRACED
-                    WSTOPPED
-                    WEXITED
-                    WCONTINUED
-                    WNOWAIT
-                    WNOTHREAD
-                    WALLCHILDREN
-                    WCLONE };
+sub madvise($$;$) {
+    _addr_len @_;
+    my ($addr, $length, $advice) = @_;
+    state $syscall_id = _get_syscall_id 'madvise';
+    my $r = syscall $syscall_id, $addr+0, $length+0, $advice+0;
+    return if $r < 0;
+    return 1;
+}
 
-{
-# Internal subs for unpacking complex proc-related structs
+sub msync($$;$) {
+    _addr_len @_;
+    my ($addr, $length, $flags) = @_;
+    state $syscall_id = _get_syscall_id 'msync';
+    my $r = syscall $syscall_id, $addr+0, $length+0, ($flags // MS_SYNC)+0;
+    return if $r < 0;
+    return 1;
+}
 
-# _unpack_siginfo returns a 6-element array: si_status, si_errno, si_code,
-# si_pid, si_uid, si_signo.
-#
-# By prefilling the struct with a known bit-pattern, we can observe that the
-# x86_64 kernel call currently writes to bytes 0~11 and 16~27, so a 28-byte or
-# 7-qword buffer is required, but <asm-generic/siginfo.h> sets SI_MAX_SIZE to
-# 128, presumably for future expansion, making the whole 140 bytes.
 #
-# si_errno only gets filled in when the waitid syscall succeeds, so it's always
-# 0, but may be observable on other syscalls.
+# Copy bytes out of, and into, memory at a raw address.
 #
-# The bytes 12~15 are left untouched; they appear to be alignment padding.
 
-# From man (2) waitid:
-#
-#   Upon successful return, waitid() fills in the following fields of the
-#   siginfo_t structure pointed to by infop:
-#
-#   si_pid      The process ID of the child.
+sub _peek($$) {
+    my ($addr, $length) = @_;
+    $length > 0 or return '';
+    return unpack "P$length", pack _ptr_packfmt, $addr;
+}
+
+# _pokev writes several ($addr, $data) pairs, in order, and with
+# process_vm_writev that's just one syscall however many there are.
+sub _pokev(@) {
+    my @pairs = @_;
+    my ($data, $remote, $count) = ( '', '', 0 );
+    while ( my ($addr, $d) = splice @pairs, 0, 2 ) {
+        length $d or next;
+        $data .= $d;
+        $remote .= pack _ptr_packfmt . 2, $addr, length $d;
+        ++$count;
+    }
+    my $length = length $data or return zero_but_true;
+    state $syscall_id = _get_syscall_id 'process_vm_writev', 1;
+    state $use_proc_mem = ! defined $syscall_id;
+    if ( ! $use_proc_mem ) {
+        my $r = syscall $syscall_id, $$+0,
+                        pack( "P$length" . _ptr_packfmt, $data, $length ), 1,
+                        $remote, $count,
+                        0;
+        return $r if $r == $length;
+        return if $r >= 0 || $! != ENOSYS && $! != EPERM;
+        $use_proc_mem = 1;
+    }
+    state $proc_mem = do { open my $fh, '+<:raw', '/proc/self/mem' or return; $fh };
+    @pairs = @_;
+    while ( my ($addr, $d) = splice @pairs, 0, 2 ) {
+        length $d or next;
+        pwrite $proc_mem, $d, $addr or return;
+    }
+    return $length;
+}
+
+sub _poke($$) {
+    return _pokev @_;
+}
+
+package Linux::Syscalls::bless::mmap {
+    sub addr   { $_[0]->[0] }
+    sub length { $_[0]->[1] }
+    sub prot   { $_[0]->[2] }
+    sub flags  { $_[0]->[3] }
+
+    sub _check_range {
+        my ($m, $offset, $length) = @_;
+        return 1 if $offset >= 0 && $length >= 0 && $offset + $length <= $m->[1] && defined $m->[0];
+        $! = Linux::Syscalls::EFAULT;
+        return;
+    }
+
+    # Copy $length bytes from $offset (or up to the end of the mapping).
+    sub peek {
+        my ($m, $offset, $length) = @_;
+        $offset //= 0;
+        $length //= $m->[1] - $offset;
+        $m->_check_range($offset, $length) or return;
+        return Linux::Syscalls::_peek $m->[0] + $offset, $length;
+    }
+
+    # Overwrite bytes starting at $offset with $data. (Writing through
+    # /proc/self/mem would ignore the protection, so check it here.)
+    sub poke {
+        my ($m, $offset, $data) = @_;
+        $m->_check_range($offset, CORE::length $data) or return;
+        if ( ! ( $m->[2] & Linux::Syscalls::PROT_WRITE ) ) {
+            $! = Linux::Syscalls::EACCES;
+            return;
+        }
+        return Linux::Syscalls::_poke $m->[0] + $offset, $data;
+    }
+
+    sub madvise {
+        my ($m, $advice, $offset, $length) = @_;
+        $offset //= 0;
+        $length //= $m->[1] - $offset;
+        return Linux::Syscalls::madvise $m->[0] + $offset, $length, $advice;
+    }
+
+    sub msync {
+        my ($m, $flags, $offset, $length) = @_;
+        $offset //= 0;
+        $length //= $m->[1] - $offset;
+        return Linux::Syscalls::msync $m->[0] + $offset, $length, $flags;
+    }
+
+    # Resize the mapping, moving it if necessary (unless $flags says otherwise)
+    sub mremap {
+        my ($m, $new_size, $flags) = @_;
+        my $r = Linux::Syscalls::mremap $m->[0], $m->[1], $new_size, $flags // Linux::Syscalls::MREMAP_MAYMOVE or return;
+        @$m[0,1] = ($r, $new_size);
+        return $m;
+    }
+
+    sub munmap {
+        my ($m) = @_;
+        defined $m->[0] or return 1;
+        Linux::Syscalls::munmap $m->[0], $m->[1] or return;
+        $m->[0] = undef;
+        return 1;
+    }
+
+    sub DESTROY { local $!; $_[0]->munmap }
+}
+
 #
-#   si_uid      The real user ID of the child.
-#               (This field is not set on most other implementations.)
+# mmap_file - map the whole (or part) of a file, opening it if a path is given.
 #
-#   si_signo    Always set to SIGCHLD.
+#   my $m = mmap_file $file, $prot, $flags, $offset, $length;
 #
-#   si_status   Either the exit status of the child, as given to _exit(2) (or
-#               exit(3)), or the signal that caused the child to terminate,
-#               stop, or continue. The si_code field can be used to determine
-#               how to interpret this field.
+# $prot defaults to PROT_READ, $flags to MAP_SHARED, $offset to 0, and $length
+# to the rest of the file.
+#
+
+sub mmap_file($;$$$$) {
+    my ($file, $prot, $flags, $offset, $length) = @_;
+    $prot //= PROT_READ;
+    $flags //= MAP_SHARED;
+    $offset //= 0;
+    my $fh = $file;
+    unless ( ref $fh || ref \$fh eq 'GLOB' || looks_like_number $fh ) {
+        undef $fh;
+        open $fh, $prot & PROT_WRITE ? '+<:raw' : '<:raw', $file or return;
+    }
+    my $fd = $fh;   # keep $fh open until the mapping is established
+    _map_fd($fd) or return;
+    $length //= ( _fd_size $fd or return ) - $offset;
+    if ($length <= 0) {
+        $! = EINVAL;
+        return;
+    }
+    return mmap undef, $length, $prot, $flags, $fd, $offset;
+}
+
+_export_tag qw{ mman =>
+    mmap munmap mremap madvise msync mmap_file
+
+    PROT_NONE PROT_READ PROT_WRITE PROT_EXEC
+
+    MAP_SHARED MAP_PRIVATE MAP_SHARED_VALIDATE MAP_FIXED MAP_FIXED_NOREPLACE
+    MAP_ANONYMOUS MAP_LOCKED MAP_NORESERVE MAP_POPULATE MAP_HUGETLB
+    MAP_FAILED
+
+    MADV_NORMAL MADV_RANDOM MADV_SEQUENTIAL MADV_WILLNEED MADV_DONTNEED
+    MADV_FREE MADV_REMOVE MADV_DONTFORK MADV_DOFORK MADV_MERGEABLE
+    MADV_UNMERGEABLE MADV_HUGEPAGE MADV_NOHUGEPAGE MADV_DONTDUMP MADV_DODUMP
+    MADV_COLD MADV_PAGEOUT MADV_POPULATE_READ MADV_POPULATE_WRITE
+
+    MS_ASYNC MS_INVALIDATE MS_SYNC
+
+    MREMAP_MAYMOVE MREMAP_FIXED MREMAP_DONTUNMAP
+};
+
+################################################################################
+
+#
+# Direct I/O (O_DIRECT) needs the file offset, the transfer length, and the
+# memory address all suitably aligned, and Perl strings make no promises about
+# the last of those; so provide buffers backed by anonymous mmap (which are
+# always page-aligned), and pread/pwrite variants that transfer directly
+# to/from such buffers.
+#
+#   my ($mem_align, $offset_align) = dio_alignment $fd;
+#
+# Uses statx(STATX_DIOALIGN) where the kernel & filesystem support it, and
+# otherwise falls back to the logical block size of the underlying block
+# device (from sysfs), or 512 if even that can't be found. Returns empty (with
+# $! set to EINVAL) if the file does not support direct I/O at all.
+#
+#   my $buf = aligned_buffer $size;
+#   my $n = pread_aligned  $fd, $buf, $count, $offset, $buf_offset;
+#   my $n = pwrite_aligned $fd, $buf, $count, $offset, $buf_offset;
+#
+# The buffer is a Linux::Syscalls::bless::mmap object, so its contents are
+# accessed with $buf->peek & $buf->poke. The alignment of $offset, $count, and
+# the buffer address (plus $buf_offset) are checked before the syscall, and
+# fail with EINVAL rather than leaving it to the filesystem, which (depending
+# on the filesystem) may instead silently fall back to buffered I/O.
+#
+
+use constant {
+    STATX_DIOALIGN      => 0x00002000,
+    statx_buffer_size   => 256,
+    # stx_mask, then from offset 136: stx_dev_major, stx_dev_minor, then from
+    # offset 152: stx_dio_mem_align, stx_dio_offset_align
+    statx_dioalign_unpack => 'Lx132LLx8LL',
+};
+
+use constant dio_default_alignment => 512;
+
+sub _statx_dioalign($) {
+    my ($fd) = @_;
+    state $syscall_id = _get_syscall_id 'statx', 1 or return;
+    my $path = '';
+    my $buffer = "\0" x statx_buffer_size;
+    my $r = syscall $syscall_id, $fd+0, $path, AT_EMPTY_PATH, STATX_DIOALIGN, $buffer;
+    return if $r < 0;
+    return unpack statx_dioalign_unpack, $buffer;
+}
+
+sub _logical_block_size($$) {
+    my ($major, $minor) = @_;
+    for my $q ( "/sys/dev/block/$major:$minor/queue", "/sys/dev/block/$major:$minor/../queue" ) {
+        open my $fh, '<', "$q/logical_block_size" or next;
+        my $size = <$fh>;
+        return $size+0 if $size && $size =~ /^\d+$/;
+    }
+    return;
+}
+
+sub dio_alignment($) {
+    my ($fd) = @_;
+    _map_fd($fd) or return;
+    if ( my ($mask, $major, $minor, $mem_align, $offset_align) = _statx_dioalign $fd ) {
+        if ( $mask & STATX_DIOALIGN ) {
+            return $mem_align, $offset_align if $offset_align;
+            $! = EINVAL;    # direct I/O not supported for this file
+            return;
+        }
+        my $size = _logical_block_size $major, $minor;
+        return ($size) x 2 if $size;
+    } elsif ( my $dev = ( stat "/proc/self/fd/$fd" )[0] ) {
+        # No statx, so decode the device number the same way as glibc
+        my $major = $dev >> 8 & 0xfff | $dev >> 32 & ~0xfff;
+        my $minor = $dev & 0xff | $dev >> 12 & ~0xff;
+        my $size = _logical_block_size $major, $minor;
+        return ($size) x 2 if $size;
+    }
+    return (dio_default_alignment) x 2;
+}
+
+sub aligned_buffer($;$) {
+    my ($size, $alignment) = @_;
+    if ( $alignment && $alignment > _page_size || $size <= 0 ) {
+        $! = EINVAL;
+        return;
+    }
+    $size = ( $size + _page_size - 1 ) & -_page_size;
+    return mmap undef, $size, PROT_READ|PROT_WRITE, MAP_PRIVATE;
+}
+
+# dio_alignment costs a statx (and perhaps a trip through sysfs), which would
+# dominate the cost of checking each transfer; so remember it per file, by
+# device & inode, leaving just an fstat to find which file $fd refers to.
+sub _dio_alignment_cached($) {
+    my ($fd) = @_;
+    state %cache;
+    my ($dev, $ino) = fstatns $fd or return;
+    my $a = $cache{"$dev:$ino"} //= do {
+        my @a = dio_alignment $fd or return;
+        \@a;
+    };
+    return @$a;
+}
+
+sub _check_dio($$$$$) {
+    my ($fd, $buffer, $count, $offset, $buf_offset) = @_;
+    if ( ! defined $buffer->addr || $buf_offset < 0 || $buf_offset + $count > $buffer->length ) {
+        $! = EFAULT;
+        return;
+    }
+    my ($mem_align, $offset_align) = _dio_alignment_cached $fd or return;
+    if (    ( $buffer->addr + $buf_offset ) % $mem_align
+         || $offset % $offset_align
+         || $count % $offset_align ) {
+        $! = EINVAL;
+        return;
+    }
+    return 1;
+}
+
+sub pread_aligned($$$$;$) {
+    my ($fd, $buffer, $count, $offset, $buf_offset) = @_;
+    _map_fd($fd) or return;
+    $buf_offset //= 0;
+    _check_dio $fd, $buffer, $count, $offset, $buf_offset or return;
+    my @offset = _loff_args $offset or return;
+    state $syscall_id = _get_syscall_id 'pread64';
+    my $r = syscall $syscall_id, $fd+0, $buffer->addr + $buf_offset, $count+0, @offset;
+    return if $r < 0;
+    return $r || zero_but_true;
+}
+
+sub pwrite_aligned($$$$;$) {
+    my ($fd, $buffer, $count, $offset, $buf_offset) = @_;
+    _map_fd($fd) or return;
+    $buf_offset //= 0;
+    _check_dio $fd, $buffer, $count, $offset, $buf_offset or return;
+    my @offset = _loff_args $offset or return;
+    state $syscall_id = _get_syscall_id 'pwrite64';
+    my $r = syscall $syscall_id, $fd+0, $buffer->addr + $buf_offset, $count+0, @offset;
+    return if $r < 0;
+    return $r || zero_but_true;
+}
+
+_export_tag qw{ dio =>
+    dio_alignment aligned_buffer pread_aligned pwrite_aligned O_DIRECT
+};
+
+################################################################################
+
+#
+# Page cache control & residency
+#
+#   posix_fadvise $fd, $offset, $length, $advice;
+#   readahead $fd, $offset, $count;
+#   my $vec = mincore $addr, $length;   # or mincore $mmap_object;
+#   my $cs = cachestat $fd, $offset, $length, $flags;
+#
+# mincore returns a string with one byte per page, whose low bit is set when
+# that page is resident; cachestat returns a Linux::Syscalls::bless::cachestat
+# object.
+#
+# cache_residency provides a per-file summary, using cachestat where the
+# kernel supports it (v6.5 onwards), and otherwise mapping the file and using
+# mincore; in the latter case only the nr_cache and nr_pages fields are filled.
+#
+#   my $cs = cache_residency $file, $offset, $length;
+#   printf "%s is %.0f%% cached\n", $file, 100 * $cs->fraction;
+#
+# A $length of 0 or undef means "to the end of the file". The file position of
+# $file (if it's a handle) is not changed. For an empty range (such as an empty
+# file) nr_pages is 0 and fraction is undef; so is fraction from a cachestat
+# call with $length 0, whose nr_pages is unknown.
+#
+# posix_fadvise and readahead take a 64-bit offset, which on 32-bit ABIs is only
+# passed correctly for ia32; elsewhere they fail with ENOSYS.
+#
+
+use constant {
+    POSIX_FADV_NORMAL       => 0,   # no special treatment
+    POSIX_FADV_RANDOM       => 1,   # expect random page references
+    POSIX_FADV_SEQUENTIAL   => 2,   # expect sequential page references
+    POSIX_FADV_WILLNEED     => 3,   # will need these pages
+    POSIX_FADV_DONTNEED     => 4,   # don't need these pages
+    POSIX_FADV_NOREUSE      => 5,   # data will be accessed once
+};
+
+#     # struct cachestat_range {
+#  Q  #     __u64 off;
+#  Q  #     __u64 len;
+#     # };
+#     # struct cachestat {
+#  Q  #     __u64 nr_cache;
+#  Q  #     __u64 nr_dirty;
+#  Q  #     __u64 nr_writeback;
+#  Q  #     __u64 nr_evicted;
+#  Q  #     __u64 nr_recently_evicted;
+#     # };
+
+use constant {
+    cachestat_range_packfmt => 'QQ',
+    cachestat_packfmt       => 'Q5',
+    cachestat_size          => 40,
+    mincore_chunk_pages     => 1 << 18,     # 1GiB with 4KiB pages
+};
+
+package Linux::Syscalls::bless::cachestat {
+    sub nr_cache            { $_[0]->[0] }
+    sub nr_dirty            { $_[0]->[1] }
+    sub nr_writeback        { $_[0]->[2] }
+    sub nr_evicted          { $_[0]->[3] }
+    sub nr_recently_evicted { $_[0]->[4] }
+    sub nr_pages            { $_[0]->[5] }  # pages in the queried range
+    sub fraction            { $_[0]->[5] ? $_[0]->[0] / $_[0]->[5] : undef }  # undef if no pages
+}
+
+sub posix_fadvise($$$$) {
+    my ($fd, $offset, $length, $advice) = @_;
+    _map_fd($fd) or return;
+    my @offset = _loff_args $offset or return;
+    state $syscall_id = _get_syscall_id 'fadvise64';
+    my $r = syscall $syscall_id, $fd+0, @offset, $length+0, $advice+0;
+    return if $r < 0;
+    return 1;
+}
+
+sub readahead($$$) {
+    my ($fd, $offset, $count) = @_;
+    _map_fd($fd) or return;
+    my @offset = _loff_args $offset or return;
+    state $syscall_id = _get_syscall_id 'readahead';
+    my $r = syscall $syscall_id, $fd+0, @offset, $count+0;
+    return if $r < 0;
+    return 1;
+}
+
+sub mincore($;$) {
+    _addr_len @_;
+    my ($addr, $length) = @_;
+    state $syscall_id = _get_syscall_id 'mincore';
+    my $vec = "\0" x ( ( $length + _page_size - 1 ) / _page_size );
+    my $r = syscall $syscall_id, $addr+0, $length+0, $vec;
+    return if $r < 0;
+    return $vec;
+}
+
+sub cachestat($$$;$) {
+    my ($fd, $offset, $length, $flags) = @_;
+    _map_fd($fd) or return;
+    state $syscall_id = _get_syscall_id 'cachestat', 1;
+    if ( ! defined $syscall_id ) {
+        $! = ENOSYS;
+        return;
+    }
+    my $range = pack cachestat_range_packfmt, $offset, $length;
+    my $buffer = "\0" x cachestat_size;
+    my $r = syscall $syscall_id, $fd+0, $range, $buffer, ($flags // 0)+0;
+    return if $r < 0;
+    my $first = int( $offset / _page_size );
+    my $pages = $length ? int( ( $offset + $length + _page_size - 1 ) / _page_size ) - $first : undef;
+    return bless [ unpack( cachestat_packfmt, $buffer ), $pages ], Linux::Syscalls::bless::cachestat::;
+}
+
+# Cleared once cachestat turns out to be missing (tests clear it to exercise
+# the mincore fallback).
+our $cache_residency_use_cachestat = 1;
+
+sub cache_residency($;$$) {
+    my ($file, $offset, $length) = @_;
+    $offset //= 0;
+    my $fh = $file;
+    unless ( ref $fh || ref \$fh eq 'GLOB' || looks_like_number $fh ) {
+        undef $fh;
+        open $fh, '<:raw', $file or return;
+    }
+    my $fd = $fh;
+    _map_fd($fd) or return;
+
+    my $size = _fd_size $fd or return;
+    $length = $size - $offset if ! $length || $offset + $length > $size;
+    $length = 0 if $length < 0;
+    my $first = int( $offset / _page_size );
+    my $pages = int( ( $offset + $length + _page_size - 1 ) / _page_size ) - $first;
+
+    if ($cache_residency_use_cachestat) {
+        if ( my $cs = cachestat $fd, $offset, $length ) {
+            $cs->[5] = $pages;
+            return $cs;
+        }
+        $! == ENOSYS or return;
+        $cache_residency_use_cachestat = 0;
+    }
+
+    # Fall back to mincore, mapping the file a chunk at a time
+    my $cached = 0;
+    for ( my $p = $first ; $p < $first + $pages ; $p += mincore_chunk_pages ) {
+        my $n = $first + $pages - $p;
+        $n = mincore_chunk_pages if $n > mincore_chunk_pages;
+        my $m = mmap undef, $n * _page_size, PROT_READ, MAP_SHARED, $fd, $p * _page_size or return;
+        my $vec = mincore $m or return;
+        $cached += unpack '%32b*', $vec & ( "\x01" x length $vec );
+    }
+    return bless [ $cached, (undef) x 4, $pages ], Linux::Syscalls::bless::cachestat::;
+}
+
+_export_tag qw{ cache =>
+    posix_fadvise readahead mincore cachestat cache_residency
+
+    POSIX_FADV_NORMAL POSIX_FADV_RANDOM POSIX_FADV_SEQUENTIAL
+    POSIX_FADV_WILLNEED POSIX_FADV_DONTNEED POSIX_FADV_NOREUSE
+};
+
+################################################################################
+
+#
+# Emulate a hangup on this process's controlling terminal, which should result
+# in all processes in this session being sent SIGHUP when they attempt to
+# interact with the terminal.
+#
+
+_export_ok 'vhangup';
+
+sub vhangup() {
+    state $syscall_id = _get_syscall_id 'vhangup';
+    return 0 == syscall $syscall_id;
+}
+
+################################################################################
+
+#
+# Exit
+#
+# Invoke the exit syscall directly, with no cleanup.
+# This may allow a process to return an exit status wider than 8 bits.
+#
+
+_export_tag qw{ proc => Exit };
+sub Exit($) {
+    my ($status) = @_;
+    state $syscall_id = _get_syscall_id 'exit_group';
+    return 0 == syscall $syscall_id, $status;
+}
+
+#
+# pidfd
+#
+
+_export_tag qw{ proc pidfs => pidfd_open };
+sub pidfd_open($;$) {
+    my ($pid, $flags) = @_;
+    state $syscall_id = _get_syscall_id 'pidfd_open';
+    my $ret = syscall $syscall_id, $pid+0, ($flags // 0)+0;
+    return if $ret < 0;
+    return $ret;
+}
+
+#
+# waitid
+#
+# Implement the POSIX waitid call and the Linux-specific extension
+# (which takes an additional parameter that has a struct times to
+# record the time usage of any reaped processses). This extension
+# does not have any official name, so I simply call it "waitid5",
+# since the syscall takes 5 parameters, analoguously to wait3 & wait4.
+#
+# Note that unlike the C version, values are returned, rather than
+# modifying parameters through pointers.
+#
+
+BEGIN {
+my %w_const = (
+
+    # Values taken from /usr/include/asm-generic/siginfo.h
+    CLD_EXITED      =>  1, #   Child has exited.
+    CLD_KILLED      =>  2, #   Child was killed.
+    CLD_DUMPED      =>  3, #   Child was killed and dumped core.
+    CLD_TRAPPED     =>  4, #   Traced child has trapped (for debugging).
+    CLD_STOPPED     =>  5, #   Child has stopped (and can be resumed).
+    CLD_CONTINUED   =>  6, #   Stopped child has continued.
+
+    # Values taken from /usr/include/linux/wait.h
+    WNOHANG         =>  0x00000001,
+    WUNTRACED       =>  0x00000002, # alias for WSTOPPED
+    WSTOPPED        =>  0x00000002, #WUNTRACED
+    WEXITED         =>  0x00000004,
+    WCONTINUED      =>  0x00000008,
+    WNOWAIT         =>  0x01000000, # Don't reap, just poll status.
+    WNOTHREAD       =>  0x20000000, # (__WNOTHREAD) Don't wait on children of other threads in this group
+    WALLCHILDREN    =>  0x40000000, # (__WALL) Wait on all children, regardless of type
+    WCLONE          =>  0x80000000, # (__WCLONE) Wait only on non-SIGCHLD children
+
+    # Values taken from /usr/include/bits/waitflags.h
+    P_ALL           =>  0,          # Any child (ignoring ID)
+    P_PID           =>  1,          # A specific child by PID
+    P_PGID          =>  2,          # Any child within a process group, by PGID
+    P_PIDFD         =>  3,          # Child identified by filedescriptor
+
+);
+    for my $k (keys %w_const) {
+        # empty list indicates that the constant is not defined; a singleton
+        # indicates defined value; a pair indicates an error...
+        my @ov = _get_scalar_constant $k or next;
+        @ov == 1 or die "Symbol $k already defined with a $ov[1] value!\n";
+        # constant $k already exists (probably from POSIX) so delete it from
+        # the list that we're about to add.
+        my $nv = delete $w_const{$k};
+        # But verify that we would provide the same numeric value.
+        $ov[0] == $nv or
+            die "Symbol $k already has value $ov[0], which disagrees our value $nv\n";
+        warn "Already have $k (probably from POSIX)\n" if $^C && $^W;
+    }
+    constant->import(\%w_const);
+};
+
+_export_tag qw{ proc si_codes =>
+                    CLD_EXITED
+                    CLD_KILLED
+                    CLD_DUMPED
+                    CLD_TRAPPED
+                    CLD_STOPPED
+                    CLD_CONTINUED };
+
+_export_tag qw{ proc wait_id_types =>
+                    P_ALL
+                    P_PID
+                    P_PGID
+                    P_PIDFD };
+
+_export_tag qw{ proc wait_options =>
+                    WNOHANG
+                    WUNTRACED
+                    WSTOPPED
+                    WEXITED
+                    WCONTINUED
+                    WNOWAIT
+                    WNOTHREAD
+                    WALLCHILDREN
+                    WCLONE };
+
+{
+# Internal subs for unpacking complex proc-related structs
+
+# _unpack_siginfo returns a 6-element array: si_signo, si_errno, si_code,
+# si_pid, si_uid, si_status.
+#
+# By prefilling the struct with a known bit-pattern, we can observe that the
+# x86_64 kernel call currently writes to bytes 0~11 and 16~27, so a 28-byte or
+# 7-qword buffer is required, but <asm-generic/siginfo.h> sets SI_MAX_SIZE to
+# 128, presumably for future expansion, making the whole 140 bytes.
+#
+# si_errno only gets filled in when the waitid syscall succeeds, so it's always
+# 0, but may be observable on other syscalls.
+#
+# The bytes 12~15 are left untouched; they appear to be alignment padding.
+
+# From man (2) waitid:
+#
+#   Upon successful return, waitid() fills in the following fields of the
+#   siginfo_t structure pointed to by infop:
+#
+#   si_pid      The process ID of the child.
+#
+#   si_uid      The real user ID of the child.
+#               (This field is not set on most other implementations.)
+#
+#   si_signo    Always set to SIGCHLD.
+#
+#   si_status   Either the exit status of the child, as given to _exit(2) (or
+#               exit(3)), or the signal that caused the child to terminate,
+#               stop, or continue. The si_code field can be used to determine
+#               how to interpret this field.
 #
 #   si_code     Set  to  one  of:
 #               CLD_EXITED  (child  called _exit(2));
@@ -2508,255 +3491,2613 @@ _export_tag qw{ proc wait_options =>
 #               CLD_TRAPPED (traced child has trapped); or
 #               CLD_CONTINUED (child continued by SIGCONT).
 #
-# however the order above is misleading, as in
-# /usr/include/asm-generic/siginfo.h the order is:
+# however the order above is misleading, as in
+# /usr/include/asm-generic/siginfo.h the order is:
+#
+#       #define SI_MAX_SIZE 128
+#       ...
+#       typedef struct siginfo {
+#           int si_signo;
+#           int si_errno;
+#           int si_code;
+#
+#           union {
+#               int _pad[SI_PAD_SIZE];
+#       ...
+#               /* SIGCHLD */
+#               struct {
+#                   __kernel_pid_t _pid;    /* which child */
+#                   __ARCH_SI_UID_T _uid;   /* sender's uid */
+#                   int _status;        /* exit code */
+#                   __ARCH_SI_CLOCK_T _utime;
+#                   __ARCH_SI_CLOCK_T _stime;
+#               } _sigchld;
+#       ...
+#           } _sifields;
+#       } __ARCH_SI_ATTRIBUTES siginfo_t;
+#
+# si_errno doesn't get mentioned because not applicable to this case: it's
+# 0 when the syscall succeeds, and untouched when the syscall fails.
+
+use constant UNPACK_SIGINFO => 'llLx[L]LLL';
+use constant EMPTY_SIGINFO  => pack UNPACK_SIGINFO, (-1) x 6;
+
+sub _unpack_siginfo($) {
+    return unpack UNPACK_SIGINFO, $_[0];
+}
+
+# _unpack_rusage returns a 16-element array, starting with the utime & stime as
+# floating-point seconds, or as given by the optional TIME_* format.
+
+use constant UNPACK_RUSAGE => 'Q18';
+use constant EMPTY_RUSAGE  => pack UNPACK_RUSAGE, (-1) x 18;
+
+sub _unpack_rusage($;$) {
+    my ($ru_utime, $ru_utime_µs, $ru_stime, $ru_stime_µs, @ru) = unpack UNPACK_RUSAGE, $_[0];
+    return  _timeval_to_seconds($ru_utime, $ru_utime_µs),
+            _timeval_to_seconds($ru_stime, $ru_stime_µs),
+            @ru
+        if ! $_[1];
+    return  _timespec_as($_[1], $ru_utime, $ru_utime_µs * 1000),
+            _timespec_as($_[1], $ru_stime, $ru_stime_µs * 1000),
+            @ru;
+}
+}
+
+# wait3 and wait4 return:
+#   empty-list (and sets $!) when there are no children, or on error
+#   0 when WNOHANG prevents immediate reaping
+#   a 17-element list otherwise
+# (always include rusage, since otherwise one could simply use waitpid)
+
+_export_tag qw{ proc => wait3 } if _get_syscall_id 'wait3', 1;
+sub wait3($;$) {
+#   unshift @_, -1;
+#   goto &wait4;
+    my ($options, $time_format) = @_;
+    my $status = pack 'I*', (0) x 1;
+    my $rusage = pack 'Q*', (0) x 18;
+    state $syscall_id = _get_syscall_id 'wait3';
+    state $debug_wait = $ENV{PERL5_DEBUG_WAIT};
+    $! = 0;
+    my $rpid = syscall $syscall_id,
+                       $status,
+                       $options,
+                       $rusage;
+    warn sprintf "Invoked\tsyscall  %u WAIT3\n"
+                ."\targs     options=%#x\n"
+                ."\treturned rpid=%d, status=%s, rusage=(%s)\n"
+                ."\terrno    %s\n",
+            $syscall_id, $options, $rpid, unpack("Q",$status), join(' ', unpack 'Q*', $rusage), $!
+        if $^C || $debug_wait;
+    $rpid > 0 or return $rpid && ();    # 0->0, -1->empty
+    $status = unpack 'I', $status;
+    my ( $ru_utime, $ru_stime,
+         $ru_maxrss, $ru_ixrss, $ru_idrss, $ru_isrss,
+         $ru_minflt, $ru_majflt, $ru_nswap, $ru_inblock, $ru_oublock,
+         $ru_msgsnd, $ru_msgrcv, $ru_nsignals, $ru_nvcsw, $ru_nivcsw) = _unpack_rusage $rusage, $time_format;
+    return $rpid,
+           $status,
+           $ru_utime, $ru_stime,
+           $ru_maxrss, $ru_ixrss, $ru_idrss, $ru_isrss,
+           $ru_minflt, $ru_majflt, $ru_nswap, $ru_inblock, $ru_oublock,
+           $ru_msgsnd, $ru_msgrcv, $ru_nsignals, $ru_nvcsw, $ru_nivcsw;
+}
+
+_export_tag qw{ proc => wait4 } if _get_syscall_id 'wait4', 1;
+sub wait4($$;$) {
+    my ($cpid, $options, $time_format) = @_;
+    my $status = pack 'I*', (0) x 1;
+    my $rusage = pack 'Q*', (0) x 18;
+    state $syscall_id = _get_syscall_id 'wait4';
+    state $debug_wait = $ENV{PERL5_DEBUG_WAIT};
+    $! = 0;
+    my $rpid = syscall $syscall_id,
+                       $cpid,
+                       $status,
+                       $options,
+                       $rusage;
+    warn sprintf "Invoked\tsyscall  %u WAIT4\n"
+                ."\targs     cpid=%d, options=%#x\n"
+                ."\treturned rpid=%d, status=(%s), rusage=(%s)\n"
+                ."\terrno    %s\n",
+                $syscall_id,
+                $cpid, $options,
+                $rpid, join(' ', unpack 'Q',$status), join(' ', unpack 'Q*', $rusage),
+                $!
+        if $^C || $debug_wait;
+    $rpid > 0 or return $rpid && ();    # 0->0, -1->empty
+    $status = unpack 'I', $status;
+    my ( $ru_utime, $ru_stime,
+         $ru_maxrss, $ru_ixrss, $ru_idrss, $ru_isrss,
+         $ru_minflt, $ru_majflt, $ru_nswap, $ru_inblock, $ru_oublock,
+         $ru_msgsnd, $ru_msgrcv, $ru_nsignals, $ru_nvcsw, $ru_nivcsw) = _unpack_rusage $rusage, $time_format;
+    return $rpid,
+           $status,
+           $ru_utime, $ru_stime,
+           $ru_maxrss, $ru_ixrss, $ru_idrss, $ru_isrss,
+           $ru_minflt, $ru_majflt, $ru_nswap, $ru_inblock, $ru_oublock,
+           $ru_msgsnd, $ru_msgrcv, $ru_nsignals, $ru_nvcsw, $ru_nivcsw;
+}
+
+# waitpid2 is like the waitpid builtin, except that it returns the pid & status
+# instead of setting $?, and returns empty (and sets $!) on error.
+
+_export_tag qw{ proc => waitpid2 } if _get_syscall_id 'waitpid', 1;
+sub waitpid2($$) {
+    my ($cpid, $options) = @_;
+    my $status = pack 'I*', (0) x 1;
+    state $syscall_id = _get_syscall_id 'waitpid';
+    $! = 0;
+    my $rpid = syscall $syscall_id,
+                       $cpid,
+                       $status,
+                       $options;
+    warn sprintf "Invoked\tsyscall  %u WAITPID\n"
+                ."\targs     cpid=%d, options=%#x\n"
+                ."\treturned rpid=%d, status=%s\n"
+                ."\terrno    %s\n",
+            $syscall_id, $cpid, $options, $rpid, unpack("H*",$status), $!;
+    $rpid > 0 or return $rpid && ();    # 0->0, -1->empty
+    $status = unpack 'I', $status;
+    return $rpid,
+           $status;
+}
+
+# waitid returns a 5-element array
+
+_export_tag qw{ proc => waitid } if _get_syscall_id 'waitid', 1;
+sub waitid($$;$) {
+#   my ($id_type, $id, $options) = @_;
+    $_[2] //= WEXITED;
+    $_[3] = 0;
+    goto &waitid_;
+}
+
+# waitid5 returns a 21-element array, starting with the same 5 as waitid
+
+_export_tag qw{ proc => waitid5 } if _get_syscall_id 'waitid', 1;
+sub waitid5($$;$) {
+#   my ($id_type, $id, $options) = @_;
+    $_[2] //= WEXITED;
+    $_[3] = 1;
+    goto &waitid_;
+}
+
+# Assume that since you're calling waitid, you have an interest in the siginfo,
+# but since the rusage is a Linux syscall extension, only include it if you
+# explicitly ask for it.
+_export_ok 'waitid_' if _get_syscall_id 'waitid', 1;
+sub waitid_($$$;$$) {
+    my ($id_type, $id, $options, $record_wrusage, $record_siginfo) = @_;
+    $id_type |= 0;  # force numeric
+    $id |= 0;       # force numeric
+    $options |= 0;  # force numeric
+    # (In scalar context the siginfo is needed to find the pid)
+    my $siginfo = EMPTY_SIGINFO if defined wantarray and $record_siginfo // 1 || ! wantarray;
+    my $wrusage = EMPTY_RUSAGE  if $record_wrusage // 0 and wantarray;
+    state $syscall_id = _get_syscall_id 'waitid';
+    $! = 0;
+    my $r = syscall $syscall_id,
+                    $id_type,
+                    $id,
+                    $siginfo // undef,
+                    $options,
+                    $wrusage // undef;
+    state $debug_waitid = $ENV{PERL5_DEBUG_WAITID};
+    warn sprintf "waitid_ invoked\n"
+                ."\tsyscall  %u\n"
+                ."\targs     type=%d, id=%d, options=%#x rec_si=%s rec_ru=%s\n"
+                ."\treturned result=%d si=%s rusage=%s\n"
+                ."\t\t errno %s (%d)\n",
+            $syscall_id,
+            $id_type,
+            $id,
+            $options,
+            $record_siginfo ? wantarray ? defined $record_siginfo ? 'record' : 'record-default' : 'omit-notwantarray' : 'omit',
+            $record_wrusage ? wantarray ? 'record' : 'omit-notwantarray' : defined $record_wrusage  ? 'omit' : 'omit-default',
+            $r,
+            defined $siginfo ? '<'.unpack('H*', $siginfo).'> ('.join(',', _unpack_siginfo $siginfo).')' : '(omitted)',
+            defined $wrusage ? '<'.unpack('H*', $wrusage).'> ('.join(',', _unpack_rusage  $wrusage).')' : '(omitted)',
+            $!, $!
+        if $^C || $debug_waitid;
+    $r == -1 and return;
+
+    # ignore si_errno, because it must be 0 if we get here.
+    my ($si_signo, undef, $si_code, $si_pid, $si_uid, $si_status, ) =
+        defined $siginfo ? _unpack_siginfo $siginfo : ();
+
+    return $si_pid if !wantarray;
+
+    my @wru = _unpack_rusage $wrusage
+        if defined $wrusage;
+
+    # Note pid & stat first, to be more consistent with other wait* calls
+    return $si_status, $si_code, $si_pid, $si_uid, $si_signo,
+           @wru;
+}
+
+################################################################################
+
+#
+# ppoll - wait for events on a set of filedescriptors
+#
+#   my %ready = ppoll { $fd1 => POLLIN, $fd2 => POLLIN|POLLOUT }, $timeout;
+#
+# Takes a hashref mapping filedescriptors to the events of interest, and
+# returns (fd, revents) pairs for those filedescriptors that are ready.
+#
+# $timeout may be in seconds (with decimal fraction) or a Time::Nanosecond
+# value; undef means wait indefinitely. On timeout returns empty with $! set to
+# 0; on error (including EINTR) returns empty with $! set.
+#
+
+use constant {
+    POLLIN      => 0x0001,
+    POLLPRI     => 0x0002,
+    POLLOUT     => 0x0004,
+    POLLERR     => 0x0008,
+    POLLHUP     => 0x0010,
+    POLLNVAL    => 0x0020,
+    POLLRDNORM  => 0x0040,
+    POLLRDBAND  => 0x0080,
+    POLLWRNORM  => 0x0100,
+    POLLWRBAND  => 0x0200,
+    POLLRDHUP   => 0x2000,
+
+    pollfd_packfmt  => 'lss',
+    pollfd_size     => 8,
+};
+
+sub ppoll($;$) {
+    my ($fd_events, $timeout) = @_;
+    my @fds = keys %$fd_events;
+    my $pollfds = pack '(' . pollfd_packfmt . ')*', map { ( $_, $fd_events->{$_}, 0 ) } @fds;
+    $timeout = pack $pack_map{timespec}, _seconds_to_timespec $timeout if defined $timeout;
+    state $syscall_id = _get_syscall_id 'ppoll';
+    $! = 0;
+    my $r = syscall $syscall_id, $pollfds, scalar @fds, $timeout // undef, undef, 0;
+    $r > 0 or return;
+    my @r;
+    for my $i (0 .. $#fds) {
+        my (undef, undef, $revents) = unpack pollfd_packfmt, substr $pollfds, $i * pollfd_size, pollfd_size;
+        push @r, $fds[$i], $revents if $revents;
+    }
+    return @r;
+}
+
+_export_tag qw{ poll =>
+    ppoll
+    POLLIN POLLPRI POLLOUT POLLERR POLLHUP POLLNVAL
+    POLLRDNORM POLLRDBAND POLLWRNORM POLLWRBAND POLLRDHUP
+};
+
+#
+# epoll - scalable readiness notification
+#
+#   my $ep = epoll_create1 EPOLL_CLOEXEC;
+#   epoll_ctl $ep, EPOLL_CTL_ADD, $sock, EPOLLIN|EPOLLRDHUP;
+#   while (my %ready = epoll_pwait2 $ep, $timeout) { ... }
+#
+# Unlike ppoll, the interest set lives in the kernel, so each wait costs time
+# proportional to the number of ready filedescriptors rather than the number
+# being watched.
+#
+# epoll_ctl takes an optional $data value (an unsigned 64-bit integer) which is
+# handed back by epoll_pwait2 in place of the filedescriptor; it defaults to
+# the filedescriptor itself.
+#
+# epoll_pwait2 returns (data, events) pairs, at most $maxevents of them
+# (default epoll_max_events). $timeout is as for ppoll. On timeout returns
+# empty with $! set to 0. On kernels before 5.11, falls back to epoll_pwait,
+# with the timeout rounded up to whole milliseconds.
+#
+# The layout of struct epoll_event varies by architecture (it's packed on
+# x86_64), so it comes from %pack_map.
+#
+
+use constant {
+    EPOLLIN         => 0x00000001,
+    EPOLLPRI        => 0x00000002,
+    EPOLLOUT        => 0x00000004,
+    EPOLLERR        => 0x00000008,
+    EPOLLHUP        => 0x00000010,
+    EPOLLRDNORM     => 0x00000040,
+    EPOLLRDBAND     => 0x00000080,
+    EPOLLWRNORM     => 0x00000100,
+    EPOLLWRBAND     => 0x00000200,
+    EPOLLMSG        => 0x00000400,
+    EPOLLRDHUP      => 0x00002000,
+    EPOLLEXCLUSIVE  => 0x10000000,
+    EPOLLWAKEUP     => 0x20000000,
+    EPOLLONESHOT    => 0x40000000,
+    EPOLLET         => 0x80000000,
+
+    EPOLL_CTL_ADD   => 1,
+    EPOLL_CTL_DEL   => 2,
+    EPOLL_CTL_MOD   => 3,
+
+    EPOLL_CLOEXEC   => 0x80000, # same as O_CLOEXEC
+
+    epoll_max_events => 256,
+};
+
+sub epoll_create1(;$) {
+    my ($flags) = @_;
+    state $syscall_id = _get_syscall_id 'epoll_create1';
+    my $r = syscall $syscall_id, ($flags // 0)+0;
+    return if $r < 0;
+    return $r;
+}
+
+sub epoll_ctl($$$;$$) {
+    my ($epfd, $op, $fd, $events, $data) = @_;
+    _map_fd($epfd) or return;
+    _map_fd($fd) or return;
+    my $event = $op == EPOLL_CTL_DEL ? undef
+              : pack $pack_map{epoll_event}, $events // 0, $data // $fd;
+    state $syscall_id = _get_syscall_id 'epoll_ctl';
+    my $r = syscall $syscall_id, $epfd+0, $op+0, $fd+0, defined $event ? $event : 0;
+    return if $r < 0;
+    return $r || zero_but_true;
+}
+
+sub epoll_pwait2($;$$) {
+    my ($epfd, $timeout, $maxevents) = @_;
+    _map_fd($epfd) or return;
+    $maxevents ||= epoll_max_events;
+    state $event_size = length pack $pack_map{epoll_event}, 0, 0;
+    my $events = "\0" x ( $maxevents * $event_size );
+    state $syscall_id = _get_syscall_id 'epoll_pwait2', 1;
+    my $r = -1;
+    $! = ENOSYS;
+    if ( $syscall_id ) {
+        my $ts = defined $timeout ? pack $pack_map{timespec}, _seconds_to_timespec $timeout : undef;
+        $r = syscall $syscall_id, $epfd+0, $events, $maxevents+0, defined $ts ? $ts : 0, 0, 0;
+    }
+    if ( $r < 0 && $! == ENOSYS ) {
+        my $ms = -1;
+        if ( defined $timeout ) {
+            my ($s, $ns) = _seconds_to_timespec $timeout;
+            $ms = $s * 1000 + int( ( $ns + 999_999 ) / 1_000_000 );
+        }
+        state $fallback_id = _get_syscall_id 'epoll_pwait';
+        $r = syscall $fallback_id, $epfd+0, $events, $maxevents+0, $ms+0, 0, 0;
+    }
+    return if $r < 0;
+    $! = 0;
+    my @r = unpack "($pack_map{epoll_event})$r", $events;
+    @r[ map { $_ ^ 1 } 0 .. $#r ];   # swap each (events, data) to (data, events)
+}
+
+_export_tag qw{ epoll =>
+    epoll_create1 epoll_ctl epoll_pwait2 epoll_max_events
+    EPOLLIN EPOLLPRI EPOLLOUT EPOLLERR EPOLLHUP EPOLLRDNORM EPOLLRDBAND
+    EPOLLWRNORM EPOLLWRBAND EPOLLMSG EPOLLRDHUP EPOLLEXCLUSIVE EPOLLWAKEUP
+    EPOLLONESHOT EPOLLET
+    EPOLL_CTL_ADD EPOLL_CTL_DEL EPOLL_CTL_MOD EPOLL_CLOEXEC
+};
+
+#
+# eventfd, timerfd & signalfd - wakeups, timers and signals as filedescriptors
+#
+#   my $efd = eventfd 0, EFD_CLOEXEC|EFD_NONBLOCK;
+#   eventfd_write $efd, 1;              # from anywhere
+#   my $n = eventfd_read $efd;          # sum of writes since last read
+#
+#   my $tfd = timerfd_create CLOCK_MONOTONIC, TFD_CLOEXEC;
+#   timerfd_settime $tfd, 0, $first, $interval;
+#   my $expirations = timerfd_read $tfd;
+#   my ($remaining, $interval) = timerfd_gettime $tfd;
+#
+#   POSIX::sigprocmask(POSIX::SIG_BLOCK, POSIX::SigSet->new(POSIX::SIGCHLD));
+#   my $sfd = signalfd undef, [ 'CHLD', 'TERM' ], SFD_CLOEXEC;
+#   for my $si ( signalfd_read $sfd ) { say $si->signo, ' from ', $si->pid }
+#
+# Each is readable when there's something to collect, so all three can be
+# waited for in one ppoll or epoll set alongside sockets and pidfds.
+#
+# Times may be given in seconds (with decimal fraction) or as
+# Time::Nanosecond::ts values, and are packed using $pack_map{timespec} so
+# that nanosecond precision is retained; timerfd_settime & timerfd_gettime
+# return (value, interval) pairs via _timespec_to_seconds, so they too are
+# Time::Nanosecond values if that module is loaded. A zero $value disarms the
+# timer; an omitted $interval means one-shot.
+#
+# signalfd takes an existing signalfd (to change its mask) or undef (to create
+# a new one), and the signals as a POSIX::SigSet or an arrayref of signal
+# numbers or names. The signals must also be blocked, otherwise they're
+# delivered as usual instead. signalfd_read returns all the pending signals
+# (up to $max) from a single read, as Linux::Syscalls::bless::signalfd_siginfo
+# objects.
+#
+# The *_read functions return empty with $! set to EAGAIN if a non-blocking
+# filedescriptor has nothing to collect.
+#
+
+use constant {
+    CLOCK_REALTIME              =>  0,
+    CLOCK_MONOTONIC             =>  1,
+    CLOCK_PROCESS_CPUTIME_ID    =>  2,
+    CLOCK_THREAD_CPUTIME_ID     =>  3,
+    CLOCK_MONOTONIC_RAW         =>  4,
+    CLOCK_REALTIME_COARSE       =>  5,
+    CLOCK_MONOTONIC_COARSE      =>  6,
+    CLOCK_BOOTTIME              =>  7,
+    CLOCK_REALTIME_ALARM        =>  8,
+    CLOCK_BOOTTIME_ALARM        =>  9,
+    CLOCK_TAI                   => 11,
+
+    EFD_SEMAPHORE               => 1,
+    EFD_CLOEXEC                 => O_CLOEXEC,
+    EFD_NONBLOCK                => O_NONBLOCK,
+
+    TFD_CLOEXEC                 => O_CLOEXEC,
+    TFD_NONBLOCK                => O_NONBLOCK,
+    TFD_TIMER_ABSTIME           => 1,
+    TFD_TIMER_CANCEL_ON_SET     => 2,
+
+    SFD_CLOEXEC                 => O_CLOEXEC,
+    SFD_NONBLOCK                => O_NONBLOCK,
+};
+
+#     # struct signalfd_siginfo {
+#  L  #     uint32_t ssi_signo;
+#  l  #     int32_t  ssi_errno;
+#  l  #     int32_t  ssi_code;
+#  L  #     uint32_t ssi_pid;
+#  L  #     uint32_t ssi_uid;
+#  l  #     int32_t  ssi_fd;
+#  L  #     uint32_t ssi_tid;
+#  L  #     uint32_t ssi_band;
+#  L  #     uint32_t ssi_overrun;
+#  L  #     uint32_t ssi_trapno;
+#  l  #     int32_t  ssi_status;
+#  l  #     int32_t  ssi_int;
+#  Q  #     uint64_t ssi_ptr;
+#  Q  #     uint64_t ssi_utime;
+#  Q  #     uint64_t ssi_stime;
+#  Q  #     uint64_t ssi_addr;
+#     #     ... padding to 128 bytes
+#     # };
+
+use constant {
+    signalfd_siginfo_packfmt    => 'LllLLlLLLLllQ4',
+    signalfd_siginfo_size       => 128,
+    signalfd_read_max           => 64,
+    _sigset_size                => 8,   # kernel sigset_t, not glibc's
+};
+
+package Linux::Syscalls::bless::signalfd_siginfo {
+    sub signo   { $_[0]->[0] }
+    sub errno   { $_[0]->[1] }
+    sub code    { $_[0]->[2] }
+    sub pid     { $_[0]->[3] }
+    sub uid     { $_[0]->[4] }
+    sub fd      { $_[0]->[5] }
+    sub tid     { $_[0]->[6] }
+    sub band    { $_[0]->[7] }
+    sub overrun { $_[0]->[8] }
+    sub trapno  { $_[0]->[9] }
+    sub status  { $_[0]->[10] }
+    sub int     { $_[0]->[11] }
+    sub ptr     { $_[0]->[12] }
+    sub utime   { $_[0]->[13] }     # clock ticks
+    sub stime   { $_[0]->[14] }     # clock ticks
+    sub addr    { $_[0]->[15] }
+}
+
+sub _read_u64($) {
+    my ($fd) = @_;
+    my $buf = '';
+    my $r = POSIX::read( $fd, $buf, 8 ) or return;
+    return unpack 'Q', $buf;
+}
+
+sub eventfd(;$$) {
+    my ($initval, $flags) = @_;
+    state $syscall_id = _get_syscall_id 'eventfd2';
+    my $r = syscall $syscall_id, ($initval // 0)+0, ($flags // 0)+0;
+    return if $r < 0;
+    return $r;
+}
+
+sub eventfd_read($) {
+    my ($fd) = @_;
+    _map_fd($fd) or return;
+    return _read_u64 $fd;
+}
+
+sub eventfd_write($;$) {
+    my ($fd, $value) = @_;
+    _map_fd($fd) or return;
+    POSIX::write( $fd, pack( 'Q', $value // 1 ), 8 ) or return;
+    return 1;
+}
+
+sub timerfd_create($;$) {
+    my ($clockid, $flags) = @_;
+    state $syscall_id = _get_syscall_id 'timerfd_create';
+    my $r = syscall $syscall_id, $clockid+0, ($flags // 0)+0;
+    return if $r < 0;
+    return $r;
+}
+
+sub _unpack_itimerspec($) {
+    my ($isec, $insec, $vsec, $vnsec) = unpack "($pack_map{timespec})2", $_[0];
+    return _timespec_to_seconds($vsec, $vnsec), _timespec_to_seconds($isec, $insec);
+}
+
+sub timerfd_settime($$$;$) {
+    my ($fd, $flags, $value, $interval) = @_;
+    _map_fd($fd) or return;
+    # struct itimerspec has it_interval before it_value
+    my $new = pack "($pack_map{timespec})2", _seconds_to_timespec $interval, _seconds_to_timespec $value;
+    my $old = "\0" x length $new;
+    state $syscall_id = _get_syscall_id 'timerfd_settime';
+    my $r = syscall $syscall_id, $fd+0, $flags+0, $new, $old;
+    return if $r < 0;
+    return _unpack_itimerspec $old if wantarray;
+    return 1;
+}
+
+sub timerfd_gettime($) {
+    my ($fd) = @_;
+    _map_fd($fd) or return;
+    my $cur = "\0" x length pack "($pack_map{timespec})2", 0, 0, 0, 0;
+    state $syscall_id = _get_syscall_id 'timerfd_gettime';
+    my $r = syscall $syscall_id, $fd+0, $cur;
+    return if $r < 0;
+    return _unpack_itimerspec $cur;
+}
+
+sub timerfd_read($) {
+    my ($fd) = @_;
+    _map_fd($fd) or return;
+    return _read_u64 $fd;
+}
+
+sub _pack_sigset($) {
+    my ($sigs) = @_;
+    my $mask = 0;
+    if ( blessed $sigs ) {
+        $sigs->ismember($_) and $mask |= 1 << $_ - 1 for 1 .. _sigset_size * 8;
+    } else {
+        state $signum = do {
+            my @names = split ' ', $Config{sig_name};
+            my @nums  = split ' ', $Config{sig_num};
+            my %n;
+            @n{@names} = @nums;
+            \%n;
+        };
+        for my $s (@$sigs) {
+            my $n = looks_like_number $s ? $s : $signum->{ $s =~ s/^SIG//r };
+            $n && $n <= _sigset_size * 8 or $! = EINVAL, return;
+            $mask |= 1 << $n - 1;
+        }
+    }
+    return pack 'Q', $mask;
+}
+
+sub signalfd($$;$) {
+    my ($fd, $sigs, $flags) = @_;
+    $fd = -1 if ! defined $fd;
+    _map_fd($fd) or return;
+    my $mask = _pack_sigset $sigs // return;
+    state $syscall_id = _get_syscall_id 'signalfd4';
+    my $r = syscall $syscall_id, $fd+0, $mask, _sigset_size, ($flags // 0)+0;
+    return if $r < 0;
+    return $r;
+}
+
+sub signalfd_read($;$) {
+    my ($fd, $max) = @_;
+    _map_fd($fd) or return;
+    my $buf = '';
+    my $r = POSIX::read( $fd, $buf, ( $max || signalfd_read_max ) * signalfd_siginfo_size ) or return;
+    return map {
+        bless [ unpack signalfd_siginfo_packfmt, substr $buf, $_ * signalfd_siginfo_size, signalfd_siginfo_size ],
+              Linux::Syscalls::bless::signalfd_siginfo::
+    } 0 .. $r / signalfd_siginfo_size - 1;
+}
+
+_export_tag qw{ eventfd =>
+    eventfd eventfd_read eventfd_write
+    EFD_SEMAPHORE EFD_CLOEXEC EFD_NONBLOCK
+};
+
+_export_tag qw{ timerfd =>
+    timerfd_create timerfd_settime timerfd_gettime timerfd_read
+    TFD_CLOEXEC TFD_NONBLOCK TFD_TIMER_ABSTIME TFD_TIMER_CANCEL_ON_SET
+};
+
+_export_tag qw{ timerfd clock =>
+    CLOCK_REALTIME CLOCK_MONOTONIC CLOCK_PROCESS_CPUTIME_ID
+    CLOCK_THREAD_CPUTIME_ID CLOCK_MONOTONIC_RAW CLOCK_REALTIME_COARSE
+    CLOCK_MONOTONIC_COARSE CLOCK_BOOTTIME CLOCK_REALTIME_ALARM
+    CLOCK_BOOTTIME_ALARM CLOCK_TAI
+};
+
+_export_tag qw{ signalfd =>
+    signalfd signalfd_read
+    SFD_CLOEXEC SFD_NONBLOCK
+};
+
+#
+# child_watcher - collect children through pidfds rather than by blocking in
+# wait*, or polling with WNOHANG.
+#
+#   my $w = child_watcher;
+#   $w->add($pid);                  # or $w->add_pidfd($pidfd, $pid)
+#
+# A pidfd becomes readable when its process terminates, so $w->fds can be
+# added to any poll or epoll set alongside other filedescriptors; when one is
+# ready, $w->reap($fd) collects that child.
+#
+# Alternatively $w->wait($timeout) polls just the watched pidfds, and reaps
+# all the children that have terminated.
+#
+# Reaped children are returned as [ $pid, \@siginfo, \@rusage ] tuples, where
+# @siginfo is as from _unpack_siginfo (si_signo, si_errno, si_code, si_pid,
+# si_uid, si_status), and @rusage is as from _unpack_rusage.
+#
+
+sub _waitid_raw($$$$$) {
+    my ($id_type, $id, $options) = @_;
+    state $syscall_id = _get_syscall_id 'waitid';
+    # $_[3] & $_[4] are the caller's siginfo & rusage buffers, filled in place
+    return syscall $syscall_id, $id_type+0, $id+0, $_[3], $options+0, defined $_[4] ? $_[4] : 0;
+}
+
+package Linux::Syscalls::child_watcher {
+
+    sub new {
+        my ($class) = @_;
+        return bless { pid => {} }, $class;
+    }
+
+    sub add {
+        my ($w, $pid) = @_;
+        my $pidfd = Linux::Syscalls::pidfd_open $pid or return;
+        return $w->add_pidfd($pidfd, $pid);
+    }
+
+    sub add_pidfd {
+        my ($w, $pidfd, $pid) = @_;
+        $w->{pid}{$pidfd} = $pid;
+        return $pidfd;
+    }
+
+    sub fds   { keys   %{ $_[0]->{pid} } }
+    sub pids  { values %{ $_[0]->{pid} } }
+    sub count { scalar keys %{ $_[0]->{pid} } }
+
+    # Returns the tuple for a terminated child, 0 if it hasn't terminated yet,
+    # or empty on error.
+    sub reap {
+        my ($w, $pidfd, $options) = @_;
+        my $pid = $w->{pid}{$pidfd} // do { $! = Linux::Syscalls::EBADF; return };
+        my $siginfo = Linux::Syscalls::EMPTY_SIGINFO;
+        my $rusage = Linux::Syscalls::EMPTY_RUSAGE;
+        my $r = Linux::Syscalls::_waitid_raw Linux::Syscalls::P_PIDFD, $pidfd,
+                    ( $options // 0 ) | Linux::Syscalls::WEXITED | Linux::Syscalls::WNOHANG,
+                    $siginfo, $rusage;
+        return if $r < 0;
+        my @si = Linux::Syscalls::_unpack_siginfo $siginfo;
+        $si[3] or return 0;     # not terminated yet
+        delete $w->{pid}{$pidfd};
+        Linux::Syscalls::closefd $pidfd;
+        return [ $pid, \@si, [ Linux::Syscalls::_unpack_rusage $rusage ] ];
+    }
+
+    # Returns the tuples for all children that terminate within $timeout, or
+    # empty on timeout or error.
+    sub wait {
+        my ($w, $timeout) = @_;
+        my $pids = $w->{pid};
+        %$pids or do { $! = POSIX::ECHILD; return };
+        my %ready = Linux::Syscalls::ppoll { map { ( $_ => Linux::Syscalls::POLLIN ) } keys %$pids }, $timeout or return;
+        return map { $w->reap($_) || () } keys %ready;
+    }
+
+    sub DESTROY {
+        my ($w) = @_;
+        Linux::Syscalls::closefd $_ for keys %{ $w->{pid} };
+    }
+}
+
+_export_tag qw{ proc pidfs => child_watcher };
+sub child_watcher() {
+    return Linux::Syscalls::child_watcher::->new;
+}
+
+#
+# reap_all - collect all children that have already terminated, in one call.
+#
+#   for ( reap_all $options, @rusage_fields ) {
+#       my ($pid, $si_status, $si_code, $si_uid, @rusage) = @$_;
+#       ...
+#   }
+#
+# Calls waitid(P_ALL, 0, ..., WEXITED|WNOHANG|$options) repeatedly until no
+# more children are ready, reusing the same siginfo & rusage buffers, and
+# returns an arrayref for each child reaped.
+#
+# Only the named rusage fields are decoded (in the order given), using an
+# unpack format that's compiled once for each distinct list of names; with no
+# names, the kernel isn't even asked to fill in the rusage. The names are:
+#
+#   utime stime maxrss ixrss idrss isrss minflt majflt nswap inblock oublock
+#   msgsnd msgrcv nsignals nvcsw nivcsw
+#
+# utime & stime are returned in seconds, as from _unpack_rusage.
+#
+# On return $! is 0 if there are children still running, or ECHILD if there are
+# none left; anything else indicates an error.
+#
+
+use constant rusage_fields => qw(
+    utime stime maxrss ixrss idrss isrss minflt majflt nswap inblock oublock
+    msgsnd msgrcv nsignals nvcsw nivcsw
+);
+
+sub _compile_rusage_unpack(@) {
+    # utime & stime are each a timeval (2 longs); the rest are 1 long each
+    state $field_offset = do {
+        my @f = rusage_fields;
+        my %h = map { ( $f[$_] => 8 * ( $_ < 2 ? 2 * $_ : $_ + 2 ) ) } 0 .. $#f;
+        \%h;
+    };
+    my @is_time;
+    my $fmt = join ' ', map {
+        my $off = $field_offset->{$_} // die "Unknown rusage field '$_'\n";
+        push @is_time, /time$/ ? 1 : 0;
+        /time$/ ? "\@${off}Q2" : "\@${off}Q";
+    } @_;
+    return $fmt, \@is_time;
+}
+
+_export_tag qw{ proc => reap_all };
+sub reap_all(;$@) {
+    my ($options, @fields) = @_;
+    $options = ( $options // 0 ) | WEXITED | WNOHANG;
+    state %compiled;
+    my ($fmt, $is_time) = @fields ? @{ $compiled{"@fields"} //= [ _compile_rusage_unpack @fields ] } : ();
+    my $siginfo = EMPTY_SIGINFO;
+    my $rusage = @fields ? EMPTY_RUSAGE : undef;
+    my $any_time = $is_time && grep { $_ } @$is_time;
+    my @r;
+    for (;;) {
+        my $r = _waitid_raw P_ALL, 0, $options, $siginfo, $rusage;
+        last if $r < 0;
+        my (undef, undef, $si_code, $si_pid, $si_uid, $si_status) = unpack UNPACK_SIGINFO, $siginfo;
+        if ( ! $si_pid ) {
+            $! = 0;
+            last;
+        }
+        if ( ! $fmt ) {
+            push @r, [ $si_pid, $si_status, $si_code, $si_uid ];
+        } elsif ( ! $any_time ) {
+            push @r, [ $si_pid, $si_status, $si_code, $si_uid, unpack $fmt, $rusage ];
+        } else {
+            my @ru = unpack $fmt, $rusage;
+            my $i = 0;
+            push @r, [ $si_pid, $si_status, $si_code, $si_uid,
+                       map { $_ ? _timeval_to_seconds( $ru[$i++], $ru[$i++] ) : $ru[$i++] } @$is_time ];
+        }
+    }
+    return @r;
+}
+
+#
+# child_profiler - resource usage of child processes, aggregated by label
+#
+#   my $prof = child_profiler;
+#   $prof->start($pid, 'gzip');             # just after fork or spawn
+#   ...
+#   $prof->collect;                         # reap whichever have finished
+#   print $prof->table;
+#
+# collect waits (by default with WNOHANG) for each child that's been started
+# but not yet finished, using waitid so that the full rusage is available.
+# Children reaped by other means can be handed over with
+#
+#   $prof->finish($pid, $si_status, @rusage);
+#
+# where @rusage is in rusage_fields order, as from waitid5, child_watcher or
+# reap_all with all of rusage_fields.
+#
+# Wall-clock start & end times are recorded as Time::Nanosecond values (from
+# CLOCK_REALTIME); $prof->records returns a hash for each finished child, with
+# keys label, pid, status, start, end, wall, cpu and each of rusage_fields.
+#
+# $prof->summary(@metrics) returns a row for each (label, metric) pair:
+#   [ $label, $metric, $count, $total, $p50, $p90, $p99, $max ]
+# and $prof->table(@metrics) formats those rows as text. The default metrics
+# are wall, cpu, utime, stime, maxrss, majflt & nivcsw; any of rusage_fields
+# may be used. Times are in seconds, and maxrss in KiB.
+#
+
+sub _realtime_now() {
+    my ($s, $ns) = _clock_gettime_raw( clock_gettime => CLOCK_REALTIME );
+    return Time::Nanosecond::new_timespec($s, $ns);
+}
+
+package Linux::Syscalls::child_profiler {
+
+    use constant default_metrics => qw( wall cpu utime stime maxrss majflt nivcsw );
+
+    sub new {
+        my ($class) = @_;
+        require Time::Nanosecond;
+        return bless { running => {}, records => [] }, $class;
+    }
+
+    sub start {
+        my ($p, $pid, $label) = @_;
+        $p->{running}{$pid} = [ $label // $pid, Linux::Syscalls::_realtime_now ];
+        return $pid;
+    }
+
+    sub finish {
+        my ($p, $pid, $status, @rusage) = @_;
+        my $end = Linux::Syscalls::_realtime_now;
+        my $run = delete $p->{running}{$pid} or return;
+        my %r;
+        @r{ Linux::Syscalls::rusage_fields() } = @rusage;
+        @r{qw( label pid status start end )} = ( $run->[0], $pid, $status, $run->[1], $end );
+        $r{wall} = 0 + ( $end - $run->[1] );
+        $r{cpu}  = $r{utime} + $r{stime};
+        push @{ $p->{records} }, \%r;
+        return \%r;
+    }
+
+    # Returns the number of children reaped.
+    sub collect {
+        my ($p, $options) = @_;
+        $options //= Linux::Syscalls::WNOHANG;
+        my $n = 0;
+        for my $pid ( keys %{ $p->{running} } ) {
+            my $siginfo = Linux::Syscalls::EMPTY_SIGINFO;
+            my $rusage = Linux::Syscalls::EMPTY_RUSAGE;
+            my $r = Linux::Syscalls::_waitid_raw Linux::Syscalls::P_PID, $pid,
+                        $options | Linux::Syscalls::WEXITED, $siginfo, $rusage;
+            if ( $r < 0 ) {
+                # Reaped elsewhere without being handed over
+                delete $p->{running}{$pid} if $! == POSIX::ECHILD;
+                next;
+            }
+            my @si = Linux::Syscalls::_unpack_siginfo $siginfo;
+            $si[3] or next;
+            $p->finish( $pid, $si[5], Linux::Syscalls::_unpack_rusage $rusage );
+            ++$n;
+        }
+        return $n;
+    }
+
+    sub running { keys %{ $_[0]->{running} } }
+    sub records { @{ $_[0]->{records} } }
+
+    # Nearest-rank percentile of a sorted list
+    sub _pct($\@) {
+        my ($pct, $v) = @_;
+        return $v->[ POSIX::ceil( $pct / 100 * @$v ) - 1 ];
+    }
+
+    sub summary {
+        my ($p, @metrics) = @_;
+        @metrics or @metrics = default_metrics;
+        my %by_label;
+        push @{ $by_label{ $_->{label} } }, $_ for @{ $p->{records} };
+        my @rows;
+        for my $label ( sort keys %by_label ) {
+            my $recs = $by_label{$label};
+            for my $m (@metrics) {
+                my @v = sort { $a <=> $b } map { $_->{$m} // 0 } @$recs;
+                my $total = 0;
+                $total += $_ for @v;
+                push @rows, [ $label, $m, scalar @v, $total,
+                              _pct( 50, @v ), _pct( 90, @v ), _pct( 99, @v ), $v[-1] ];
+            }
+        }
+        return @rows;
+    }
+
+    sub table {
+        my ($p, @metrics) = @_;
+        my @rows = $p->summary(@metrics) or return '';
+        my $lw = 5;
+        length $_->[0] > $lw and $lw = length $_->[0] for @rows;
+        my $t = sprintf "%-*s %-8s %7s %14s %12s %12s %12s %12s\n",
+                        $lw, qw( label metric count total p50 p90 p99 max );
+        for (@rows) {
+            my ($label, $m, $count, @v) = @$_;
+            my $f = $m =~ /time$|^wall$|^cpu$/ ? '%.3f' : '%.0f';
+            $t .= sprintf "%-*s %-8s %7d %14s %12s %12s %12s %12s\n",
+                          $lw, $label, $m, $count, map { sprintf $f, $_ } @v;
+        }
+        return $t;
+    }
+}
+
+_export_tag qw{ proc => child_profiler };
+sub child_profiler() {
+    return Linux::Syscalls::child_profiler::->new;
+}
+
+################################################################################
+
+sub _pack_exec_args($$$) {
+    my ($argv, $envp, $keep) = @_;
+    if ( ref $envp eq 'HASH' ) {
+        $envp = [ map { "$_=$envp->{$_}" } keys %$envp ];
+    }
+    # pack 'p' takes pointers into these strings, so they must outlive the
+    # packed arrays; hence $keep
+    @$keep = ( [ map { "$_" } @$argv ], [ map { "$_" } @$envp ] );
+    return map { pack 'p*', @$_, undef } @$keep;
+}
+
+# execveat like execve but takes fd+filepath+flags instead of filepath
+# (This is Linux-specific)
+_export_tag qw{ proc exec => execveat };
+sub execveat($$\@;\@$) {
+    my ($dir_fd, $path, $argv, $envp, $flags) = @_;
+    # Follow symlinks unless told otherwise; /usr/bin/perl often is one
+    _resolve_dir_fd_path $dir_fd, $path, $flags, 0 or return;
+    ($argv, $envp) = _pack_exec_args $argv, $envp || [], \my @keep;
+    state $syscall_id = _get_syscall_id 'execveat';
+    my $r = syscall $syscall_id,
+                    $dir_fd+0,
+                    $path,
+                    $argv,
+                    $envp,
+                    $flags+0;
+    $r == -1 and return;
+    return $r;
+}
+
+# fexecve can be implemented either using execveat or /proc/$pid/fd/$fd
+_export_tag qw{ proc exec => fexecve };
+sub fexecve($\@;\@) {
+    splice @_, 1, 0, undef;     # empty path
+    goto &execveat;
+}
+
+################################################################################
+#
+# close_range - close, or mark close-on-exec, a range of filedescriptors
+#
+#   close_range 3;                              # everything from 3 upwards
+#   close_range 3, undef, CLOSE_RANGE_CLOEXEC;  # ... but only upon exec
+#
+# $last defaults to the highest possible filedescriptor.
+#
+# Before Linux 5.9 (or 5.11 for CLOSE_RANGE_CLOEXEC), falls back to listing
+# /proc/self/fd with getdents, so that only the filedescriptors that are
+# actually open are touched, rather than trying every number up to the
+# rlimit; CLOSE_RANGE_UNSHARE is then emulated with unshare(CLONE_FILES).
+#
+# Any Perl filehandles using the closed filedescriptors are not told about it.
+#
+
+use constant {
+    CLOSE_RANGE_UNSHARE     => 2,
+    CLOSE_RANGE_CLOEXEC     => 4,
+
+    _CLONE_FILES            => 0x400,
+    _F_SETFD                => 2,
+    _FD_CLOEXEC             => 1,
+    _max_fd                 => 0xffffffff,
+};
+
+sub _fd_syscall_id($) {
+    state %syscall_id;
+    return $syscall_id{$_[0]} //= _get_syscall_id $_[0], 1;
+}
+
+sub _fd_syscall($@) {
+    my $syscall_id = _fd_syscall_id shift or $! = ENOSYS, return;
+    my $r = syscall $syscall_id, map { $_+0 } @_;
+    return if $r < 0;
+    return $r || zero_but_true;
+}
+
+sub _open_fds() {
+    my $dir = POSIX::open( '/proc/self/fd', O_RDONLY | O_DIRECTORY | O_CLOEXEC ) // return;
+    my @fds;
+    $! = 0;
+    while ( my @e = getdents $dir ) {
+        defined $e[0] or last;
+        push @fds, map { $_->name } @e;
+    }
+    my $e = $!;
+    POSIX::close($dir);
+    $! = $e, return if $e;
+    return grep { $_ != $dir } @fds;
+}
+
+_export_tag qw{ proc exec =>
+    close_range CLOSE_RANGE_UNSHARE CLOSE_RANGE_CLOEXEC
+};
+sub close_range($;$$) {
+    my ($first, $last, $flags) = @_;
+    $last = _max_fd if ! defined $last || $last > _max_fd;
+    $flags //= 0;
+    my $r = _fd_syscall close_range => $first, $last, $flags;
+    return $r if $r;
+    $! == ENOSYS || $! == EINVAL && $flags & CLOSE_RANGE_CLOEXEC or return;
+
+    _fd_syscall unshare => _CLONE_FILES or return
+        if $flags & CLOSE_RANGE_UNSHARE;
+    $! = 0;
+    my @fds = grep { $first <= $_ && $_ <= $last } _open_fds;
+    return if $!;
+    if ( $flags & CLOSE_RANGE_CLOEXEC ) {
+        _fd_syscall fcntl => $_, _F_SETFD, _FD_CLOEXEC for @fds;
+    } else {
+        POSIX::close($_) for @fds;
+    }
+    return zero_but_true;
+}
+
+################################################################################
+#
+# spawn - start another program, returning a pidfd
 #
-#       #define SI_MAX_SIZE 128
-#       ...
-#       typedef struct siginfo {
-#           int si_signo;
-#           int si_errno;
-#           int si_code;
+#   my $pidfd = spawn '/usr/bin/gzip', [ 'gzip', '-9' ], {
+#       fds       => { 0 => $in, 1 => $out },   # target fd => source fd/handle
+#       cwd       => $dir_fd,                   # fchdir before exec
+#       close_fds => 1,                         # close everything else
+#       env       => { PATH => '/usr/bin' },    # hash or list of "K=V"
+#   };
+#   my ($pidfd, $pid) = spawn undef, \@argv, { dir_fd => $o_path_fd };
 #
-#           union {
-#               int _pad[SI_PAD_SIZE];
-#       ...
-#               /* SIGCHLD */
-#               struct {
-#                   __kernel_pid_t _pid;    /* which child */
-#                   __ARCH_SI_UID_T _uid;   /* sender's uid */
-#                   int _status;        /* exit code */
-#                   __ARCH_SI_CLOCK_T _utime;
-#                   __ARCH_SI_CLOCK_T _stime;
-#               } _sigchld;
+# The program is named by $path relative to $opts->{dir_fd} (or to the new
+# working directory if dir_fd is omitted), or by dir_fd itself if $path is
+# undef, exactly as for execveat; there is no $PATH search. $argv defaults to
+# [ $path ], and env to %ENV.
+#
+# The child is created by clone3 with CLONE_VFORK|CLONE_PIDFD, so the pidfd
+# is obtained atomically, and the parent is not resumed until the child has
+# either called execveat or given up; any failure in the child (including
+# execveat itself) is reported back through a close-on-exec pipe, so that
+# spawn returns empty with $! set rather than leaving a child that exits 127.
+#
+# CLONE_VM is deliberately not used: unlike C's vfork, the child here is still
+# running the Perl interpreter, which would trample the parent's stack and
+# heap before it got as far as execveat. So the page tables are still copied,
+# just as for fork, and the cost of spawning still grows with the size of the
+# parent; what spawn saves is the separate pidfd_open (and its race against
+# pid reuse) and the guesswork over whether the exec worked.
+#
+# Where clone3 isn't available (before Linux 5.3, or blocked by a seccomp
+# filter) falls back to fork followed by pidfd_open.
+#
+# In the child, the fds remapping is done via temporary close-on-exec
+# duplicates, so swapping (eg, { 1 => 2, 2 => 1 }) works. close_fds uses
+# close_range to mark all other filedescriptors above 2 as close-on-exec (so
+# that the error pipe remains open until the exec succeeds), which takes a
+# single syscall however many filedescriptors there might be.
+#
+
+use constant {
+    CLONE_VM                =>        0x100,
+    CLONE_PIDFD             =>       0x1000,
+    CLONE_VFORK             =>       0x4000,
+    CLONE_CLEAR_SIGHAND     =>      1 << 32,
+    CLONE_INTO_CGROUP       =>      1 << 33,
+
+    clone_args_packfmt      => 'Q11',
+        # flags pidfd child_tid parent_tid exit_signal stack stack_size tls
+        # set_tid set_tid_size cgroup
+
+    _F_DUPFD_CLOEXEC        => 1030,
+};
+
+sub spawn($;$$) {
+    my ($path, $argv, $opts) = @_;
+    $opts ||= {};
+    my $dir_fd = $opts->{dir_fd};
+    my $flags;
+    $argv ||= [ $path // '' ];
+    _resolve_dir_fd_path $dir_fd, $path, $flags, 0 or return;
+    my ($argp, $envp) = _pack_exec_args $argv, $opts->{env} // \%ENV, \my @keep;
+
+    my %fds;
+    for my $target ( keys %{ $opts->{fds} // {} } ) {
+        my $source = $opts->{fds}{$target};
+        _map_fd($source) or return;
+        $fds{$target} = $source;
+    }
+    my $cwd = $opts->{cwd};
+    !defined $cwd || _map_fd($cwd) or return;
+    my $above = 3;
+    $above = $_ + 1 for grep { $_ >= $above } sort { $a <=> $b } keys %fds;
+
+    # Look these up now, rather than separately in each child
+    _fd_syscall_id $_ for qw( fcntl dup3 fchdir close_range execveat );
+
+    pipe my $err_r, my $err_w or return;
+
+    my $pidfd = pack 'l', -1;
+    state $clone3_id = _get_syscall_id 'clone3', 1;
+    my $pid = -1;
+    $! = ENOSYS;
+    if ( $clone3_id ) {
+        my $args = pack clone_args_packfmt,
+                        CLONE_VFORK | CLONE_PIDFD,
+                        unpack( _ptr_packfmt, pack 'p', $pidfd ),
+                        0, 0, POSIX::SIGCHLD(), 0, 0, 0, 0, 0, 0;
+        $pid = syscall $clone3_id, $args, length $args;
+    }
+    if ( $pid < 0 ) {
+        $! == ENOSYS || $! == EPERM or return;
+        $pid = fork // return;
+        $pidfd = undef;
+    }
+
+    if ( $pid == 0 ) {
+        # Child: no die, no return, no destructors
+        my $e = fileno $err_w;
+        eval {
+            # Keep the error pipe out of the way of the remapping
+            $e = _fd_syscall fcntl => $e, _F_DUPFD_CLOEXEC, $above or die if $e < $above;
+            my %tmp = map {
+                ( $_ => _fd_syscall( fcntl => $fds{$_}, _F_DUPFD_CLOEXEC, $above ) // die )
+            } keys %fds;
+            _fd_syscall dup3 => $tmp{$_}, $_, 0 or die for keys %tmp;
+            _fd_syscall fchdir => $cwd or die if defined $cwd;
+            if ( $opts->{close_fds} ) {
+                my $first = 3;
+                for my $keep ( ( sort { $a <=> $b } grep { $_ >= 3 } keys %fds ), 1 << 32 ) {
+                    close_range $first, $keep - 1, CLOSE_RANGE_CLOEXEC or die
+                        if $keep > $first;
+                    $first = $keep + 1;
+                }
+            }
+            syscall _fd_syscall_id 'execveat', $dir_fd+0, $path, $argp, $envp, $flags+0;
+            die;
+        };
+        POSIX::write( $e, pack( 'l', $! + 0 ), 4 );
+        POSIX::_exit(127);
+    }
+
+    close $err_w;
+    my ($n, $errno);
+    1 until defined( $n = sysread $err_r, $errno, 4 ) || ! $!{EINTR};
+    if ( ! defined $n ) {
+        # Can't tell whether the exec worked, so don't leave the child behind
+        $errno = pack 'l', $! + 0;
+        kill 'KILL', $pid;
+    }
+    close $err_r;
+    if ( ! defined $n || $n ) {
+        waitpid $pid, 0;
+        POSIX::close( unpack 'l', $pidfd ) if defined $pidfd;
+        $! = unpack 'l', $errno;
+        return;
+    }
+    $pidfd = defined $pidfd ? unpack 'l', $pidfd : pidfd_open($pid) // return;
+    return wantarray ? ( $pidfd, $pid ) : $pidfd;
+}
+
+_export_tag qw{ proc exec pidfs => spawn };
+
+################################################################################
+#
+# proc_scan - a snapshot of the process table
+#
+#   for my $p ( proc_scan { pidfd => 1 } ) {
+#       printf "%d %s %.2fs %dKiB\n", $p->pid, $p->comm, $p->cpu, $p->rss_kib;
+#       kill_via_pidfd($p->pidfd) if ...;
+#   }
+#
+# Lists /proc with getdents (keeping only the all-digit names), then for each
+# process opens /proc/$pid with openat relative to the /proc dirfd, and reads
+# its stat and statm files (relative to that) with a single read each; no
+# processes are started, and no text other than those two lines is parsed.
+#
+# Returns a Linux::Syscalls::bless::proc_stat object for each process; those
+# that exit part way through the scan are silently omitted.
+#
+# Options:
+#   statm => 0      skip reading statm (size, resident & shared are then undef)
+#   pidfd => 1      also open a pidfd for each process, for use in follow-up
+#                   actions (signals, waits, etc) that must not be misdirected
+#                   to an unrelated process that later reuses the pid; the
+#                   caller is responsible for closing them.
+#
+# Because the pidfd is opened while the /proc/$pid dirfd is held, and stat is
+# read through that dirfd afterwards, the record and the pidfd are guaranteed
+# to describe the same process: if the pid had already been reused, the read
+# would fail with ESRCH and the process would be omitted.
+#
+
+use constant {
+    proc_scan_getdents_bufsize  => 0x10000,
+    proc_stat_read_size         => 0x400,
+};
+
+package Linux::Syscalls::bless::proc_stat {
+    use constant _clk_tck => POSIX::sysconf( POSIX::_SC_CLK_TCK() ) || 100;
+    sub pid         { $_[0]->[0]  }
+    sub comm        { $_[0]->[1]  }
+    sub state       { $_[0]->[2]  }
+    sub ppid        { $_[0]->[3]  }
+    sub pgrp        { $_[0]->[4]  }
+    sub session     { $_[0]->[5]  }
+    sub tty_nr      { $_[0]->[6]  }
+    sub minflt      { $_[0]->[7]  }
+    sub majflt      { $_[0]->[8]  }
+    sub utime       { $_[0]->[9]  / _clk_tck }  # seconds
+    sub stime       { $_[0]->[10] / _clk_tck }  # seconds
+    sub cpu         { ( $_[0]->[9] + $_[0]->[10] ) / _clk_tck }
+    sub nice        { $_[0]->[11] }
+    sub num_threads { $_[0]->[12] }
+    sub starttime   { $_[0]->[13] / _clk_tck }  # seconds since boot
+    sub vsize       { $_[0]->[14] }             # bytes
+    sub rss         { $_[0]->[15] }             # pages
+    sub rss_kib     { $_[0]->[15] * Linux::Syscalls::_page_size / 1024 }
+    sub size        { $_[0]->[16] }             # pages, from statm
+    sub resident    { $_[0]->[17] }             # pages, from statm
+    sub shared      { $_[0]->[18] }             # pages, from statm
+    sub pidfd       { $_[0]->[19] }
+}
+
+sub _read_at($$) {
+    my ($dir_fd, $name) = @_;
+    state $syscall_id = _get_syscall_id 'openat';
+    my $fd = syscall $syscall_id, $dir_fd+0, $name, O_RDONLY | O_CLOEXEC, 0;
+    return if $fd < 0;
+    my $buf = '';
+    my $r = POSIX::read( $fd, $buf, proc_stat_read_size );
+    POSIX::close($fd);
+    return $r ? $buf : ();
+}
+
+_export_tag qw{ proc => proc_scan };
+sub proc_scan(;$) {
+    my ($opts) = @_;
+    my $want_statm = $opts->{statm} // 1;
+    my $want_pidfd = $opts->{pidfd};
+    my $proc = openat undef, '/proc', O_RDONLY | O_DIRECTORY | O_CLOEXEC or return;
+    my @pids;
+    $! = 0;
+    while ( my @e = getdents $proc, proc_scan_getdents_bufsize ) {
+        defined $e[0] or last;
+        push @pids, grep { /^\d+$/ } map { $_->name } @e;
+    }
+    my @r;
+    for my $pid (@pids) {
+        my $dir = openat $proc, $pid, O_RDONLY | O_DIRECTORY | O_CLOEXEC or next;
+        my $pidfd = $want_pidfd ? pidfd_open $pid : undef;
+        my $stat = _read_at $dir, 'stat';
+        my $statm = $want_statm && defined $stat ? _read_at $dir, 'statm' : undef;
+        POSIX::close($dir);
+        if ( ! defined $stat ) {
+            POSIX::close($pidfd) if defined $pidfd;
+            next;
+        }
+        # comm may contain spaces and parentheses, so look for the last ')'
+        my $c = rindex $stat, ')';
+        my $comm = substr $stat, 0, $c;
+        $comm =~ s/^\d+ \(//;
+        my @f = split ' ', substr $stat, $c + 2;
+        push @r, bless [
+            $pid+0, $comm,
+            @f[ 0 .. 4 ],       # state ppid pgrp session tty_nr
+            @f[ 7, 9 ],         # minflt majflt
+            @f[ 11, 12 ],       # utime stime
+            @f[ 16, 17 ],       # nice num_threads
+            @f[ 19 .. 21 ],     # starttime vsize rss
+            defined $statm ? ( split ' ', $statm )[ 0 .. 2 ] : ( undef ) x 3,
+            $pidfd,
+        ], Linux::Syscalls::bless::proc_stat::;
+    }
+    POSIX::close($proc);
+    return @r;
+}
+
+################################################################################
+#
+# CPU affinity & scheduling
+#
+#   my ($cpu, $node) = getcpu;
+#   sched_setaffinity $pid, [ 0, 2, 4 ];    # or a vec() bit-string
+#   my @cpus = sched_getaffinity $pid;      # bit-string in scalar context
+#   sched_setattr $pid, { policy => SCHED_BATCH, nice => 5 };
+#   my $attr = sched_getattr $pid;          # hashref, keys as below
+#
+# A $pid of 0 (or undef) means the calling thread.
+#
+# CPU sets may be given either as an arrayref of CPU numbers, or as a
+# bit-string such as built by vec($bits, $cpu, 1) = 1; either way they're
+# packed as the kernel's array of unsigned longs.
+#
+# The sched_attr keys are policy, flags, nice, priority, runtime, deadline,
+# period, util_min & util_max; runtime, deadline & period are in nanoseconds,
+# and only matter for SCHED_DEADLINE.
+#
+# numa_node_cpus returns a hashref mapping each NUMA node number to an arrayref
+# of its CPUs, from /sys/devices/system/node; on a non-NUMA system all the CPUs
+# are on node 0.
+#
+# pin_round_robin pins a process (typically a freshly forked worker) to one of
+# the CPUs that the caller may use, chosen by $index; or with $by eq 'node',
+# to all the allowed CPUs of one NUMA node. It returns the CPUs chosen.
+#
+#   for my $i ( 0 .. $workers-1 ) {
+#       my $pid = fork // die;
+#       if ( ! $pid ) { pin_round_robin 0, $i; worker(); exit }
+#   }
+#
+
+use constant {
+    SCHED_OTHER             => 0,
+    SCHED_FIFO              => 1,
+    SCHED_RR                => 2,
+    SCHED_BATCH             => 3,
+    SCHED_IDLE              => 5,
+    SCHED_DEADLINE          => 6,
+
+    SCHED_FLAG_RESET_ON_FORK    => 0x01,
+    SCHED_FLAG_RECLAIM          => 0x02,
+    SCHED_FLAG_DL_OVERRUN       => 0x04,
+    SCHED_FLAG_KEEP_POLICY      => 0x08,
+    SCHED_FLAG_KEEP_PARAMS      => 0x10,
+    SCHED_FLAG_UTIL_CLAMP_MIN   => 0x20,
+    SCHED_FLAG_UTIL_CLAMP_MAX   => 0x40,
+};
+
+#     # struct sched_attr {
+#  L  #     __u32 size;
+#  L  #     __u32 sched_policy;
+#  Q  #     __u64 sched_flags;
+#  l  #     __s32 sched_nice;
+#  L  #     __u32 sched_priority;
+#  Q  #     __u64 sched_runtime;
+#  Q  #     __u64 sched_deadline;
+#  Q  #     __u64 sched_period;
+#  L  #     __u32 sched_util_min;
+#  L  #     __u32 sched_util_max;
+#     # };
+
+use constant {
+    sched_attr_packfmt      => 'LLQlLQQQLL',
+    sched_attr_size         => 56,
+
+    _cpu_mask_word_bits     => 8 * $Config{longsize},
+    _cpu_mask_initial_size  => 128,     # bytes; enough for 1024 CPUs
+};
+
+use constant sched_attr_fields => qw(
+    policy flags nice priority runtime deadline period util_min util_max
+);
+
+# Bitmasks (of CPUs or NUMA nodes) are arrays of words; bit N is bit N%W of
+# word N/W, which only matches the byte order of vec() on little-endian hosts.
+sub _pack_bitmask($;$) {
+    my ($set, $word_bits) = @_;
+    $word_bits ||= _cpu_mask_word_bits;
+    my @bits = ref $set ? @$set : grep { vec $set, $_, 1 } 0 .. 8 * length($set) - 1;
+    my @w;
+    for my $n (@bits) {
+        $n >= 0 or $! = EINVAL, return;
+        $w[ $n / $word_bits ] |= 1 << $n % $word_bits;
+    }
+    return pack $word_bits == 64 ? 'Q*' : 'L*', map { $_ // 0 } @w;
+}
+
+sub _unpack_bitmask($;$) {
+    my ($mask, $word_bits) = @_;
+    $word_bits ||= _cpu_mask_word_bits;
+    my @w = unpack $word_bits == 64 ? 'Q*' : 'L*', $mask;
+    my @bits;
+    for my $i ( 0 .. $#w ) {
+        my $w = $w[$i] or next;
+        for my $b ( 0 .. $word_bits - 1 ) {
+            push @bits, $i * $word_bits + $b if $w >> $b & 1;
+        }
+    }
+    return @bits;
+}
+
+_export_tag qw{ sched => getcpu };
+sub getcpu() {
+    my $cpu = pack 'L', 0;
+    my $node = pack 'L', 0;
+    state $syscall_id = _get_syscall_id 'getcpu';
+    my $r = syscall $syscall_id, $cpu, $node, 0;
+    return if $r < 0;
+    return wantarray ? ( unpack( 'L', $cpu ), unpack( 'L', $node ) ) : unpack 'L', $cpu;
+}
+
+_export_tag qw{ sched => sched_setaffinity };
+sub sched_setaffinity($$) {
+    my ($pid, $set) = @_;
+    my $mask = _pack_bitmask($set) // return;
+    state $syscall_id = _get_syscall_id 'sched_setaffinity';
+    my $r = syscall $syscall_id, ($pid // 0)+0, length $mask, $mask;
+    return if $r < 0;
+    return 1;
+}
+
+_export_tag qw{ sched => sched_getaffinity };
+sub sched_getaffinity(;$) {
+    my ($pid) = @_;
+    state $syscall_id = _get_syscall_id 'sched_getaffinity';
+    for ( my $size = _cpu_mask_initial_size ;; $size <<= 1 ) {
+        my $mask = "\0" x $size;
+        my $r = syscall $syscall_id, ($pid // 0)+0, $size, $mask;
+        if ( $r < 0 ) {
+            # EINVAL means the mask is smaller than the kernel's
+            $! == EINVAL && $size < 1 << 20 and next;
+            return;
+        }
+        my @cpus = _unpack_bitmask substr $mask, 0, $r;
+        return @cpus if wantarray;
+        my $bits = '';
+        vec( $bits, $_, 1 ) = 1 for @cpus;
+        return $bits;
+    }
+}
+
+_export_tag qw{ sched => sched_setattr };
+sub sched_setattr($$;$) {
+    my ($pid, $attr, $flags) = @_;
+    my $buf = pack sched_attr_packfmt, sched_attr_size, map { ( $attr->{$_} // 0 )+0 } sched_attr_fields;
+    state $syscall_id = _get_syscall_id 'sched_setattr';
+    my $r = syscall $syscall_id, ($pid // 0)+0, $buf, ($flags // 0)+0;
+    return if $r < 0;
+    return 1;
+}
+
+_export_tag qw{ sched => sched_getattr };
+sub sched_getattr(;$) {
+    my ($pid) = @_;
+    my $buf = "\0" x sched_attr_size;
+    state $syscall_id = _get_syscall_id 'sched_getattr';
+    my $r = syscall $syscall_id, ($pid // 0)+0, $buf, sched_attr_size, 0;
+    return if $r < 0;
+    my (undef, @v) = unpack sched_attr_packfmt, $buf;
+    my %attr;
+    @attr{ +sched_attr_fields } = @v;
+    return \%attr;
+}
+
+sub _parse_cpu_list($) {
+    map { /^(\d+)-(\d+)$/ ? $1 .. $2 : /^\d+$/ ? $_ : () } split /,/, $_[0] =~ s/\s+//gr;
+}
+
+_export_tag qw{ sched => numa_node_cpus };
+sub numa_node_cpus() {
+    my %nodes;
+    for my $dir ( glob '/sys/devices/system/node/node[0-9]*' ) {
+        my ($node) = $dir =~ /(\d+)$/;
+        open my $fh, '<', "$dir/cpulist" or next;
+        $nodes{$node} = [ _parse_cpu_list( scalar <$fh> // '' ) ];
+    }
+    %nodes or $nodes{0} = [ sched_getaffinity 0 ];
+    return \%nodes;
+}
+
+_export_tag qw{ sched => pin_round_robin };
+sub pin_round_robin($$;$) {
+    my ($pid, $index, $by) = @_;
+    my @allowed = sched_getaffinity 0 or return;
+    my @cpus;
+    if ( ( $by // 'cpu' ) eq 'node' ) {
+        my %allowed = map { ( $_ => 1 ) } @allowed;
+        my $nodes = numa_node_cpus;
+        my @sets = grep { @$_ } map { [ grep { $allowed{$_} } @{ $nodes->{$_} } ] }
+                                sort { $a <=> $b } keys %$nodes;
+        @sets or $! = EINVAL, return;
+        @cpus = @{ $sets[ $index % @sets ] };
+    } else {
+        @cpus = $allowed[ $index % @allowed ];
+    }
+    sched_setaffinity $pid, \@cpus or return;
+    return @cpus;
+}
+
+_export_tag qw{ sched =>
+    SCHED_OTHER SCHED_FIFO SCHED_RR SCHED_BATCH SCHED_IDLE SCHED_DEADLINE
+    SCHED_FLAG_RESET_ON_FORK SCHED_FLAG_RECLAIM SCHED_FLAG_DL_OVERRUN
+    SCHED_FLAG_KEEP_POLICY SCHED_FLAG_KEEP_PARAMS
+    SCHED_FLAG_UTIL_CLAMP_MIN SCHED_FLAG_UTIL_CLAMP_MAX
+};
+
+################################################################################
+#
+# NUMA memory policy
+#
+#   set_mempolicy MPOL_BIND, [ 0 ];                 # this thread's allocations
+#   my ($mode, @nodes) = get_mempolicy;
+#   my $node = get_mempolicy $addr, MPOL_F_NODE|MPOL_F_ADDR;
+#   mbind $addr, $length, MPOL_INTERLEAVE, [ 0, 1 ];    # or mbind $mmap, ...
+#   my @where = move_pages 0, \@addrs;              # node of each page
+#   my @status = move_pages 0, \@addrs, \@nodes, MPOL_MF_MOVE;
+#
+# Node sets are given as for CPU sets (an arrayref of node numbers or a vec()
+# bit-string). They're packed as arrays of the kernel's unsigned long, whose
+# size is taken from $Linux::Syscalls::generic::m32; maxnode is passed as the
+# number of bits plus one, to allow for the kernel's historical off-by-one.
+#
+# Mode flags (MPOL_F_STATIC_NODES, MPOL_F_RELATIVE_NODES) are or'ed into $mode.
+#
+# move_pages returns, for each page, the node it's on (after any move), or a
+# negative errno value (eg -ENOENT for a page that isn't present).
+#
+# numa_bind_local binds the calling thread's future allocations to the node of
+# the CPU it's running on, which makes sense after pin_round_robin; it returns
+# that node. The $mode defaults to MPOL_BIND; MPOL_PREFERRED falls back to
+# other nodes rather than failing when the local node is full.
+#
+
+use constant {
+    MPOL_DEFAULT                => 0,
+    MPOL_PREFERRED              => 1,
+    MPOL_BIND                   => 2,
+    MPOL_INTERLEAVE             => 3,
+    MPOL_LOCAL                  => 4,
+    MPOL_PREFERRED_MANY         => 5,
+    MPOL_WEIGHTED_INTERLEAVE    => 6,
+
+    MPOL_F_NUMA_BALANCING       => 1 << 13,
+    MPOL_F_RELATIVE_NODES       => 1 << 14,
+    MPOL_F_STATIC_NODES         => 1 << 15,
+
+    MPOL_F_NODE                 => 1,   # get_mempolicy: return a node, not a mode
+    MPOL_F_ADDR                 => 2,   # get_mempolicy: look up $addr
+    MPOL_F_MEMS_ALLOWED         => 4,   # get_mempolicy: allowed nodes
+
+    MPOL_MF_STRICT              => 1,
+    MPOL_MF_MOVE                => 2,
+    MPOL_MF_MOVE_ALL            => 4,
+
+    _node_mask_initial_bits     => 1024,
+};
+
+sub _node_mask_word_bits() {
+    no warnings 'once';
+    return $Linux::Syscalls::generic::m32 ? 32 : 64;
+}
+
+sub _pack_node_mask($) {
+    my ($nodes) = @_;
+    defined $nodes or return ( 0, 0 );  # NULL mask
+    my $mask = _pack_bitmask( $nodes, _node_mask_word_bits ) // return;
+    $mask .= "\0" x ( _node_mask_word_bits / 8 ) if $mask eq '';
+    return $mask, 8 * length($mask) + 1;
+}
+
+_export_tag qw{ numa => set_mempolicy };
+sub set_mempolicy($;$) {
+    my ($mode, $nodes) = @_;
+    my ($mask, $maxnode) = _pack_node_mask $nodes or return;
+    state $syscall_id = _get_syscall_id 'set_mempolicy';
+    my $r = syscall $syscall_id, $mode+0, $mask, $maxnode+0;
+    return if $r < 0;
+    return 1;
+}
+
+_export_tag qw{ numa => get_mempolicy };
+sub get_mempolicy(;$$) {
+    my ($addr, $flags) = @_;
+    state $syscall_id = _get_syscall_id 'get_mempolicy';
+    for ( my $bits = _node_mask_initial_bits ;; $bits <<= 1 ) {
+        my $mode = pack 'l', 0;
+        my $mask = "\0" x ( $bits / 8 );
+        my $r = syscall $syscall_id, $mode, $mask, $bits+1, ($addr // 0)+0, ($flags // 0)+0;
+        if ( $r < 0 ) {
+            # EINVAL may just mean the mask is smaller than the kernel's
+            $! == EINVAL && $bits < 1 << 16 and next;
+            return;
+        }
+        $mode = unpack 'l', $mode;
+        return $mode if ! wantarray || ( $flags // 0 ) & MPOL_F_NODE;
+        return $mode, _unpack_bitmask $mask, _node_mask_word_bits;
+    }
+}
+
+_export_tag qw{ numa => mbind };
+sub mbind($$$;$$) {
+    _addr_len @_;
+    my ($addr, $length, $mode, $nodes, $flags) = @_;
+    my ($mask, $maxnode) = _pack_node_mask $nodes or return;
+    state $syscall_id = _get_syscall_id 'mbind';
+    my $r = syscall $syscall_id, $addr+0, $length+0, $mode+0, $mask, $maxnode+0, ($flags // 0)+0;
+    return if $r < 0;
+    return 1;
+}
+
+_export_tag qw{ numa => move_pages };
+sub move_pages($$;$$) {
+    my ($pid, $addrs, $nodes, $flags) = @_;
+    my $count = @$addrs;
+    my $pages = pack _ptr_packfmt . '*', @$addrs;
+    my $node_list = $nodes ? pack 'l*', @$nodes : undef;
+    my $status = pack 'l*', (0) x $count;
+    state $syscall_id = _get_syscall_id 'move_pages';
+    my $r = syscall $syscall_id, ($pid // 0)+0, $count+0, $pages,
+                    defined $node_list ? $node_list : 0, $status, ($flags // 0)+0;
+    return if $r < 0;
+    return unpack 'l*', $status;
+}
+
+_export_tag qw{ numa => numa_bind_local };
+sub numa_bind_local(;$) {
+    my ($mode) = @_;
+    my (undef, $node) = getcpu or return;
+    set_mempolicy $mode // MPOL_BIND, [ $node ] or return;
+    return $node;
+}
+
+_export_tag qw{ numa =>
+    MPOL_DEFAULT MPOL_PREFERRED MPOL_BIND MPOL_INTERLEAVE MPOL_LOCAL
+    MPOL_PREFERRED_MANY MPOL_WEIGHTED_INTERLEAVE
+    MPOL_F_NUMA_BALANCING MPOL_F_RELATIVE_NODES MPOL_F_STATIC_NODES
+    MPOL_F_NODE MPOL_F_ADDR MPOL_F_MEMS_ALLOWED
+    MPOL_MF_STRICT MPOL_MF_MOVE MPOL_MF_MOVE_ALL
+};
+
+#
+# clock_gettime, clock_getres & clock_nanosleep - POSIX clocks
+#
+#   my $now = clock_gettime CLOCK_MONOTONIC_RAW;
+#   my $res = clock_getres CLOCK_BOOTTIME;
+#   my $cpu = clock_gettime clock_getcpuclockid $pid;
+#   clock_nanosleep CLOCK_MONOTONIC, TIMER_ABSTIME, $deadline;
+#
+# Any clock ID may be used, including the per-process & per-thread CPU clocks
+# given by clock_getcpuclockid($pid) & clock_getcpuclockid($tid, 1) (a $pid of
+# 0 meaning the calling process). Times are returned via _timespec_as, so as
+# Time::Nanosecond::ts values when that's loaded, or as given by a trailing
+# TIME_* format, and may be given in seconds or as Time::Nanosecond values.
+#
+# clock_nanosleep returns true once the time is reached, and otherwise empty
+# with $! set; a relative sleep that's interrupted by a signal returns (undef,
+# $remaining) in list context.
+#
+# ticker - a periodic loop without drift
+#
+#   my $tick = ticker 0.001;            # 1 kHz, by CLOCK_MONOTONIC
+#   while (1) {
+#       my $n = $tick->wait;            # > 1 if ticks were missed
 #       ...
-#           } _sifields;
-#       } __ARCH_SI_ATTRIBUTES siginfo_t;
+#   }
+#
+# Each deadline is a whole number of periods after the first, and wait sleeps
+# until the next one with TIMER_ABSTIME, so neither the time taken by the loop
+# body nor the latency of waking up accumulates. If the loop overruns, missed
+# deadlines are skipped rather than run back-to-back; wait returns how many
+# periods have passed, and $tick->missed the total skipped so far.
 #
-# si_errno doesn't get mentioned because not applicable to this case: it's
-# 0 when the syscall succeeds, and untouched when the syscall fails.
 
-use constant UNPACK_SIGINFO => 'llLx[L]LLL';
-use constant EMPTY_SIGINFO  => pack UNPACK_SIGINFO, (-1) x 6;
+use constant {
+    TIMER_ABSTIME   => 1,
+};
 
-sub _unpack_siginfo($) {
-    return unpack UNPACK_SIGINFO, $_[0];
+sub _clock_gettime_raw($$) {
+    my ($name, $clock_id) = @_;
+    my $ts = pack $pack_map{timespec}, 0, 0;
+    my $r = syscall _fd_syscall_id($name), $clock_id+0, $ts;
+    return if $r < 0;
+    return unpack $pack_map{timespec}, $ts;
+}
+
+_export_tag qw{ clock => clock_gettime };
+sub clock_gettime($;$) {
+    my ($clock_id, $time_format) = @_;
+    my ($s, $ns) = _clock_gettime_raw clock_gettime => $clock_id or return;
+    return _timespec_as $time_format, $s, $ns;
+}
+
+_export_tag qw{ clock => clock_getres };
+sub clock_getres($;$) {
+    my ($clock_id, $time_format) = @_;
+    my ($s, $ns) = _clock_gettime_raw clock_getres => $clock_id or return;
+    return _timespec_as $time_format, $s, $ns;
+}
+
+# CPU-time clock IDs are made from the ID's complement, as in the kernel's
+# MAKE_PROCESS_CPUCLOCK & MAKE_THREAD_CPUCLOCK with CPUCLOCK_SCHED.
+_export_tag qw{ clock => clock_getcpuclockid };
+sub clock_getcpuclockid($;$) {
+    my ($id, $is_thread) = @_;
+    return $is_thread ? CLOCK_THREAD_CPUTIME_ID : CLOCK_PROCESS_CPUTIME_ID if ! $id;
+    return ( -$id - 1 ) * 8 + 2 + ( $is_thread ? 4 : 0 );
+}
+
+_export_tag qw{ clock => clock_nanosleep };
+sub clock_nanosleep($$$) {
+    my ($clock_id, $flags, $time) = @_;
+    my $req = pack $pack_map{timespec}, _seconds_to_timespec $time;
+    my $rem = $flags & TIMER_ABSTIME ? undef : "\0" x length $req;
+    state $syscall_id = _get_syscall_id 'clock_nanosleep';
+    my $r = syscall $syscall_id, $clock_id+0, $flags+0, $req, $rem // 0;
+    return zero_but_true if $r >= 0;
+    return if ! wantarray || ! $!{EINTR} || ! defined $rem;
+    my ($s, $ns) = unpack $pack_map{timespec}, $rem;
+    return undef, _timespec_to_seconds $s, $ns;
+}
+
+# Deadlines are kept as integer nanoseconds
+sub _timespec_to_ns(@) { return $_[0] * 1_000_000_000 + $_[1] }
+sub _ns_to_timespec($) { use integer; return $_[0] / 1_000_000_000, $_[0] % 1_000_000_000 }
+
+package Linux::Syscalls::ticker {
+
+    # Sleeps until the next deadline, returning the number of periods since
+    # the previous one (more than 1 if the caller overran)
+    sub wait {
+        my ($tk) = @_;
+        my $req = pack $pack_map{timespec}, Linux::Syscalls::_ns_to_timespec $tk->{next};
+        state $syscall_id = Linux::Syscalls::_get_syscall_id 'clock_nanosleep';
+        for (;;) {
+            my $r = syscall $syscall_id, $tk->{clock}+0, Linux::Syscalls::TIMER_ABSTIME, $req, 0;
+            last if $r >= 0;
+            $!{EINTR} or return;
+        }
+        my ($s, $ns) = Linux::Syscalls::_clock_gettime_raw( clock_gettime => $tk->{clock} ) or return;
+        my $now = Linux::Syscalls::_timespec_to_ns $s, $ns;
+        my $n = do { use integer; 1 + ( $now - $tk->{next} ) / $tk->{period} };
+        $tk->{next} += $n * $tk->{period};
+        $tk->{missed} += $n - 1;
+        return $n;
+    }
+
+    # The next deadline, in integer nanoseconds by the ticker's clock
+    sub next_ns     { return $_[0]->{next}   }
+    sub period_ns   { return $_[0]->{period} }
+    sub missed      { return $_[0]->{missed} }
+}
+
+_export_tag qw{ clock => ticker };
+sub ticker($;$) {
+    my ($period, $clock_id) = @_;
+    $clock_id //= CLOCK_MONOTONIC;
+    my $period_ns = _timespec_to_ns _seconds_to_timespec $period;
+    $period_ns > 0 or do { $! = EINVAL; return };
+    my ($s, $ns) = _clock_gettime_raw clock_gettime => $clock_id or return;
+    my $now = _timespec_to_ns $s, $ns;
+    return bless {
+        clock   => $clock_id,
+        period  => $period_ns,
+        next    => $now + $period_ns,
+        missed  => 0,
+    }, Linux::Syscalls::ticker::;
+}
+
+_export_tag qw{ clock => TIMER_ABSTIME };
+
+################################################################################
+#
+# Reporting for the per-syscall counters (see Linux::Syscalls::stats near the
+# top of this file). Set PERL5_SYSCALL_STATS=1 in the environment before this
+# module is loaded to collect them, or PERL5_SYSCALL_STATS=report to also have
+# syscall_report printed to STDERR at exit. When they weren't compiled in,
+# these fail with ENOSYS.
+#
+# syscall_stats returns a hash-ref keyed by syscall name, each value being
+#   { calls => $n, ns => $total_elapsed_ns, errors => { ENOENT => $n, ... } }
+
+sub _errno_name($) {
+    my ($n) = @_;
+    state %name;
+    return $name{$n} //= do {
+        local $! = $n;
+        my ($k) = grep { $!{$_} } keys %!;
+        $k // $n;
+    };
+}
+
+_export_tag qw{ stats => syscall_stats };
+sub syscall_stats() {
+    _SYSCALL_STATS or $! = ENOSYS, return;
+    my %r;
+    for my $name (keys %Linux::Syscalls::stats::calls) {
+        my $e = $Linux::Syscalls::stats::errors{$name} // {};
+        $r{$name} = {
+            calls   => $Linux::Syscalls::stats::calls{$name},
+            ns      => int $Linux::Syscalls::stats::ns{$name},
+            errors  => { map { ( _errno_name $_ => $e->{$_} ) } keys %$e },
+        };
+    }
+    return \%r;
+}
+
+_export_tag qw{ stats => syscall_stats_reset };
+sub syscall_stats_reset() {
+    _SYSCALL_STATS or $! = ENOSYS, return;
+    %$_ = () for \%Linux::Syscalls::stats::calls,
+                 \%Linux::Syscalls::stats::ns,
+                 \%Linux::Syscalls::stats::errors;
+    return 1;
+}
+
+# A table of the counters, busiest first
+_export_tag qw{ stats => syscall_report };
+sub syscall_report() {
+    my $st = syscall_stats or return;
+    my @names = sort { $st->{$b}{ns} <=> $st->{$a}{ns} || $a cmp $b } keys %$st;
+    my $w = 7;
+    length $_ > $w and $w = length $_ for @names;
+    my $t = sprintf "%-*s %9s %7s %14s %10s  %s\n",
+                    $w, qw( syscall calls errors total_ns mean_ns errno );
+    for my $name (@names) {
+        my $r = $st->{$name};
+        my $e = $r->{errors};
+        my $errors = 0;
+        $errors += $_ for values %$e;
+        $t .= sprintf "%-*s %9d %7d %14d %10d  %s\n",
+                      $w, $name, $r->{calls}, $errors, $r->{ns}, $r->{ns} / $r->{calls},
+                      join ' ', map { "$_=$e->{$_}" } sort keys %$e;
+    }
+    return $t;
+}
+
+################################################################################
+#
+# perf_event_open - hardware & software performance counters
+#
+# Constants from /usr/include/linux/perf_event.h
+#
+# Hardware counters are generally unavailable inside virtual machines, but the
+# software ones (task-clock, context-switches, page-faults, cpu-migrations)
+# work anywhere. When /proc/sys/kernel/perf_event_paranoid is 2 or more,
+# unprivileged processes can only count their own user-space activity, so
+# perf_counters falls back to setting exclude_kernel & exclude_hv (which means
+# that context switches, being in the kernel, aren't counted).
+
+use constant {
+    PERF_TYPE_HARDWARE              => 0,
+    PERF_TYPE_SOFTWARE              => 1,
+    PERF_TYPE_TRACEPOINT            => 2,
+    PERF_TYPE_HW_CACHE              => 3,
+    PERF_TYPE_RAW                   => 4,
+    PERF_TYPE_BREAKPOINT            => 5,
+
+    PERF_COUNT_HW_CPU_CYCLES        => 0,
+    PERF_COUNT_HW_INSTRUCTIONS      => 1,
+    PERF_COUNT_HW_CACHE_REFERENCES  => 2,
+    PERF_COUNT_HW_CACHE_MISSES      => 3,
+    PERF_COUNT_HW_BRANCH_INSTRUCTIONS => 4,
+    PERF_COUNT_HW_BRANCH_MISSES     => 5,
+    PERF_COUNT_HW_BUS_CYCLES        => 6,
+
+    PERF_COUNT_SW_CPU_CLOCK         => 0,
+    PERF_COUNT_SW_TASK_CLOCK        => 1,
+    PERF_COUNT_SW_PAGE_FAULTS       => 2,
+    PERF_COUNT_SW_CONTEXT_SWITCHES  => 3,
+    PERF_COUNT_SW_CPU_MIGRATIONS    => 4,
+    PERF_COUNT_SW_PAGE_FAULTS_MIN   => 5,
+    PERF_COUNT_SW_PAGE_FAULTS_MAJ   => 6,
+    PERF_COUNT_SW_ALIGNMENT_FAULTS  => 7,
+    PERF_COUNT_SW_EMULATION_FAULTS  => 8,
+
+    PERF_FORMAT_TOTAL_TIME_ENABLED  => 1,
+    PERF_FORMAT_TOTAL_TIME_RUNNING  => 2,
+    PERF_FORMAT_ID                  => 4,
+    PERF_FORMAT_GROUP               => 8,
+
+    PERF_FLAG_FD_NO_GROUP           => 1,
+    PERF_FLAG_FD_OUTPUT             => 2,
+    PERF_FLAG_PID_CGROUP            => 4,
+    PERF_FLAG_FD_CLOEXEC            => 8,
+
+    PERF_IOC_FLAG_GROUP             => 1,
+};
+
+use constant {
+    PERF_EVENT_IOC_ENABLE   => Linux::Syscalls::ioctl::_IO(  ord '$', 0 ),
+    PERF_EVENT_IOC_DISABLE  => Linux::Syscalls::ioctl::_IO(  ord '$', 1 ),
+    PERF_EVENT_IOC_RESET    => Linux::Syscalls::ioctl::_IO(  ord '$', 3 ),
+    PERF_EVENT_IOC_ID       => Linux::Syscalls::ioctl::_IOR( ord '$', 7, $Config{ptrsize} ),
+};
+
+_export_tag qw{ perf =>
+    PERF_TYPE_HARDWARE PERF_TYPE_SOFTWARE PERF_TYPE_TRACEPOINT PERF_TYPE_HW_CACHE
+    PERF_TYPE_RAW PERF_TYPE_BREAKPOINT
+    PERF_COUNT_HW_CPU_CYCLES PERF_COUNT_HW_INSTRUCTIONS
+    PERF_COUNT_HW_CACHE_REFERENCES PERF_COUNT_HW_CACHE_MISSES
+    PERF_COUNT_HW_BRANCH_INSTRUCTIONS PERF_COUNT_HW_BRANCH_MISSES
+    PERF_COUNT_HW_BUS_CYCLES
+    PERF_COUNT_SW_CPU_CLOCK PERF_COUNT_SW_TASK_CLOCK PERF_COUNT_SW_PAGE_FAULTS
+    PERF_COUNT_SW_CONTEXT_SWITCHES PERF_COUNT_SW_CPU_MIGRATIONS
+    PERF_COUNT_SW_PAGE_FAULTS_MIN PERF_COUNT_SW_PAGE_FAULTS_MAJ
+    PERF_COUNT_SW_ALIGNMENT_FAULTS PERF_COUNT_SW_EMULATION_FAULTS
+    PERF_FORMAT_TOTAL_TIME_ENABLED PERF_FORMAT_TOTAL_TIME_RUNNING
+    PERF_FORMAT_ID PERF_FORMAT_GROUP
+    PERF_FLAG_FD_NO_GROUP PERF_FLAG_FD_OUTPUT PERF_FLAG_PID_CGROUP
+    PERF_FLAG_FD_CLOEXEC
+    PERF_IOC_FLAG_GROUP
+};
+
+#     # struct perf_event_attr {   (PERF_ATTR_SIZE_VER0; the kernel accepts
+#     #                             shorter versions and zero-fills the rest)
+#  L  #     __u32 type;
+#  L  #     __u32 size;
+#  Q  #     __u64 config;
+#  Q  #     __u64 sample_period;    /* or sample_freq */
+#  Q  #     __u64 sample_type;
+#  Q  #     __u64 read_format;
+#  Q  #     __u64 disabled:1, inherit:1, ... (see %perf_attr_bit)
+#  L  #     __u32 wakeup_events;    /* or wakeup_watermark */
+#  L  #     __u32 bp_type;
+#  Q  #     __u64 config1;          /* or bp_addr */
+#     # };
+
+use constant {
+    perf_event_attr_packfmt     => 'LLQQQQQLLQ',
+    perf_event_attr_size        => 64,
+};
+
+# Bit positions in the flags word, counted from the least significant bit on
+# little-endian machines, and from the most significant on big-endian ones.
+my %perf_attr_bit = (
+    disabled        =>  0,  inherit         =>  1,  pinned          =>  2,
+    exclusive       =>  3,  exclude_user    =>  4,  exclude_kernel  =>  5,
+    exclude_hv      =>  6,  exclude_idle    =>  7,  mmap            =>  8,
+    comm            =>  9,  freq            => 10,  inherit_stat    => 11,
+    enable_on_exec  => 12,  task            => 13,  watermark       => 14,
+    mmap_data       => 17,  sample_id_all   => 18,  exclude_host    => 19,
+    exclude_guest   => 20,
+);
+
+my %perf_attr_field = map { ( $_ => 1 ) }
+    qw( type config sample_period sample_type read_format wakeup_events bp_type config1 );
+
+sub _pack_perf_event_attr($) {
+    my ($attr) = @_;
+    state $big_endian = $Config{byteorder} !~ /^1/;
+    my $flags = 0;
+    for my $k (keys %$attr) {
+        next if $perf_attr_field{$k};
+        my $bit = $perf_attr_bit{$k} // do { $! = EINVAL; return };
+        $flags |= 1 << ( $big_endian ? 63 - $bit : $bit ) if $attr->{$k};
+    }
+    return pack perf_event_attr_packfmt,
+                ( $attr->{type} // PERF_TYPE_SOFTWARE )+0,
+                perf_event_attr_size,
+                map( { ( $attr->{$_} // 0 )+0 } qw( config sample_period sample_type read_format ) ),
+                $flags,
+                map( { ( $attr->{$_} // 0 )+0 } qw( wakeup_events bp_type config1 ) );
+}
+
+# perf_event_open takes the perf_event_attr fields and flag bits as a hash, for
+# example
+#
+#   my $fd = perf_event_open { config => PERF_COUNT_SW_TASK_CLOCK, exclude_kernel => 1 };
+#
+# (type defaults to PERF_TYPE_SOFTWARE), then the target pid (default 0, this
+# process), cpu (default -1, any), group leader (default none) and flags
+# (default PERF_FLAG_FD_CLOEXEC). It returns a filedescriptor.
+
+_export_tag qw{ perf => perf_event_open };
+sub perf_event_open($;$$$$) {
+    my ($attr, $pid, $cpu, $group_fd, $flags) = @_;
+    my $a = _pack_perf_event_attr $attr // return;
+    if ( defined $group_fd ) {
+        _map_fd($group_fd) or return;
+    } else {
+        $group_fd = -1;
+    }
+    state $syscall_id = _get_syscall_id 'perf_event_open';
+    my $r = syscall $syscall_id, $a, ( $pid // 0 )+0, ( $cpu // -1 )+0, $group_fd+0, ( $flags // PERF_FLAG_FD_CLOEXEC )+0;
+    return if $r < 0;
+    return $r;
 }
 
-# _unpack_rusage returns a 16-element array, starting with the utime & stime as
-# floating-point seconds.
+sub _perf_ioctl($$$) {
+    my ($fd, $request, $group) = @_;
+    _map_fd($fd) or return;
+    return _fd_syscall ioctl => $fd, $request, $group ? PERF_IOC_FLAG_GROUP : 0;
+}
 
-use constant UNPACK_RUSAGE => 'Q18';
-use constant EMPTY_RUSAGE  => pack UNPACK_RUSAGE, (-1) x 18;
+# Each of these applies to the whole group when given a true second argument
+# and the group leader.
+_export_tag qw{ perf => perf_event_enable perf_event_disable perf_event_reset };
+sub perf_event_enable($;$)  { return _perf_ioctl $_[0], PERF_EVENT_IOC_ENABLE,  $_[1]; }
+sub perf_event_disable($;$) { return _perf_ioctl $_[0], PERF_EVENT_IOC_DISABLE, $_[1]; }
+sub perf_event_reset($;$)   { return _perf_ioctl $_[0], PERF_EVENT_IOC_RESET,   $_[1]; }
 
-sub _unpack_rusage($) {
-    my ($ru_utime, $ru_utime_µs, $ru_stime, $ru_stime_µs, @ru) = unpack UNPACK_RUSAGE, $_[0];
-    return  _timeval_to_seconds($ru_utime, $ru_utime_µs),
-            _timeval_to_seconds($ru_stime, $ru_stime_µs),
-            @ru;
+# The kernel-assigned ID that perf_event_read reports with PERF_FORMAT_ID
+_export_tag qw{ perf => perf_event_id };
+sub perf_event_id($) {
+    my ($fd) = @_;
+    _map_fd($fd) or return;
+    my $id = pack 'Q', 0;
+    state $syscall_id = _get_syscall_id 'ioctl';
+    my $r = syscall $syscall_id, $fd+0, PERF_EVENT_IOC_ID, $id;
+    return if $r < 0;
+    return unpack 'Q', $id;
 }
+
+# perf_event_read needs the read_format that the event was opened with, and
+# returns a hash-ref containing
+#   value                       (unless PERF_FORMAT_GROUP)
+#   values & ids                (array-refs, with PERF_FORMAT_GROUP; ids only
+#                                with PERF_FORMAT_ID)
+#   id                          (with PERF_FORMAT_ID, unless PERF_FORMAT_GROUP)
+#   time_enabled, time_running  (in nanoseconds, with the corresponding flags)
+# A group is read in a single syscall, so its counts are mutually consistent.
+
+_export_tag qw{ perf => perf_event_read };
+sub perf_event_read($;$$) {
+    my ($fd, $read_format, $max_members) = @_;
+    _map_fd($fd) or return;
+    $read_format //= 0;
+    my $group = $read_format & PERF_FORMAT_GROUP;
+    my $len = 8 * ( 3 + ( $group ? 2 * ( $max_members || 64 ) : 1 ) );
+    my $buf = '';
+    my $n = POSIX::read( $fd, $buf, $len ) or return;
+    my @v = unpack 'Q*', $buf;
+    my %r;
+    my $nr = $group ? shift @v : 1;
+    $r{value} = shift @v if ! $group;
+    $r{time_enabled} = shift @v if $read_format & PERF_FORMAT_TOTAL_TIME_ENABLED;
+    $r{time_running} = shift @v if $read_format & PERF_FORMAT_TOTAL_TIME_RUNNING;
+    if ( ! $group ) {
+        $r{id} = shift @v if $read_format & PERF_FORMAT_ID;
+    } elsif ( $read_format & PERF_FORMAT_ID ) {
+        $r{values} = [ map { $v[2*$_]   } 0 .. $nr-1 ];
+        $r{ids}    = [ map { $v[2*$_+1] } 0 .. $nr-1 ];
+    } else {
+        $r{values} = [ @v[0 .. $nr-1] ];
+    }
+    return \%r;
 }
 
-# wait3 and wait4 return:
-#   empty-list (and sets $!) when there are no children, or on error
-#   0 when WNOHANG prevents immediate reaping
-#   a 17-element list otherwise
-# (always include rusage, since otherwise one could simply use waitpid)
+# perf_counters opens a group of counters on this process, named as in perf(1):
+#
+#   my $pc = perf_counters qw( task-clock context-switches page-faults ) or die;
+#   my $counts = $pc->measure( sub { ... } );
+#   printf "%s %d\n", $_, $counts->{$_} for sort keys %$counts;
+#
+# or [type, config] pairs for anything else. An optional leading hash-ref can
+# override pid, cpu, and the perf_event_attr flags.
+#
+# The counters start disabled; enable, disable and reset act on them all
+# together, and read returns a hash of name => count (and in list context also
+# the nanoseconds that the group was enabled and running, which differ only
+# when hardware counters have been multiplexed).
+
+my %perf_event_by_name = (
+    'cycles'            => [ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES ],
+    'instructions'      => [ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS ],
+    'cache-references'  => [ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES ],
+    'cache-misses'      => [ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES ],
+    'branches'          => [ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS ],
+    'branch-misses'     => [ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES ],
+    'bus-cycles'        => [ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BUS_CYCLES ],
+    'cpu-clock'         => [ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_CLOCK ],
+    'task-clock'        => [ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK ],
+    'page-faults'       => [ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS ],
+    'context-switches'  => [ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES ],
+    'cpu-migrations'    => [ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS ],
+    'minor-faults'      => [ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MIN ],
+    'major-faults'      => [ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS_MAJ ],
+    'alignment-faults'  => [ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_ALIGNMENT_FAULTS ],
+    'emulation-faults'  => [ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_EMULATION_FAULTS ],
+);
 
-_export_tag qw{ proc => wait3 } if _get_syscall_id 'wait3', 1;
-sub wait3($) {
-#   unshift @_, -1;
-#   goto &wait4;
-    my ($options) = @_;
-    my $status = pack 'I*', (0) x 1;
-    my $rusage = pack 'Q*', (0) x 18;
-    state $syscall_id = _get_syscall_id 'wait3';
-    $! = 0;
-    my $rpid = syscall $syscall_id,
-                       $status,
-                       $options,
-                       $rusage;
-    warn sprintf "Invoked\tsyscall  %u WAIT3\n"
-                ."\targs     options=%#x\n"
-                ."\treturned rpid=%d, status=%s, rusage=(%s)\n"
-                ."\terrno    %s\n",
-            $syscall_id, $options, $rpid, unpack("Q",$status), join(' ', unpack 'Q*', $rusage), $!;
-    $rpid > 0 or return $rpid && ();    # 0->0, -1->empty
-    $status = unpack 'I', $status;
-    my ( $ru_utime, $ru_stime,
-         $ru_maxrss, $ru_ixrss, $ru_idrss, $ru_isrss,
-         $ru_minflt, $ru_majflt, $ru_nswap, $ru_inblock, $ru_oublock,
-         $ru_msgsnd, $ru_msgrcv, $ru_nsignals, $ru_nvcsw, $ru_nivcsw) = _unpack_rusage $rusage;
-    return $rpid,
-           $status,
-           $ru_utime, $ru_stime,
-           $ru_maxrss, $ru_ixrss, $ru_idrss, $ru_isrss,
-           $ru_minflt, $ru_majflt, $ru_nswap, $ru_inblock, $ru_oublock,
-           $ru_msgsnd, $ru_msgrcv, $ru_nsignals, $ru_nvcsw, $ru_nivcsw;
+package Linux::Syscalls::perf_group {
+    use POSIX ();
+
+    sub new {
+        my ($class, @events) = @_;
+        my %opt = ref $events[0] eq 'HASH' ? %{ shift @events } : ();
+        my ($pid, $cpu) = delete @opt{qw( pid cpu )};
+        @events or $! = POSIX::EINVAL(), return;
+        my $pg = bless { fds => [], names => [], by_id => {} }, $class;
+        for my $e (@events) {
+            my ($type, $config) = @{ ref $e ? $e : $perf_event_by_name{$e} // do { $! = POSIX::EINVAL(); return } };
+            my $leader = $pg->{fds}[0];
+            my %attr = (
+                %opt,
+                type            => $type,
+                config          => $config,
+                disabled        => !defined $leader,
+                read_format     => $pg->read_format,
+            );
+            my $fd = Linux::Syscalls::perf_event_open \%attr, $pid, $cpu, $leader;
+            if ( !defined $fd && !defined $leader && !exists $opt{exclude_kernel} && ( $!{EACCES} || $!{EPERM} ) ) {
+                # Not allowed to count in the kernel, so settle for user space
+                $opt{exclude_kernel} = $opt{exclude_hv} = 1;
+                $fd = Linux::Syscalls::perf_event_open { %attr, %opt }, $pid, $cpu;
+            }
+            defined $fd or return;
+            push @{ $pg->{fds} }, $fd;
+            push @{ $pg->{names} }, ref $e ? "$type:$config" : $e;
+            my $id = Linux::Syscalls::perf_event_id($fd) // return;
+            $pg->{by_id}{$id} = $pg->{names}[-1];
+        }
+        return $pg;
+    }
+
+    sub read_format {
+        return Linux::Syscalls::PERF_FORMAT_GROUP
+             | Linux::Syscalls::PERF_FORMAT_ID
+             | Linux::Syscalls::PERF_FORMAT_TOTAL_TIME_ENABLED
+             | Linux::Syscalls::PERF_FORMAT_TOTAL_TIME_RUNNING;
+    }
+
+    sub names   { return @{ $_[0]->{names} } }
+    sub enable  { return Linux::Syscalls::perf_event_enable(  $_[0]->{fds}[0], 1 ) }
+    sub disable { return Linux::Syscalls::perf_event_disable( $_[0]->{fds}[0], 1 ) }
+    sub reset   { return Linux::Syscalls::perf_event_reset(   $_[0]->{fds}[0], 1 ) }
+
+    sub read {
+        my ($pg) = @_;
+        my $r = Linux::Syscalls::perf_event_read( $pg->{fds}[0], $pg->read_format, scalar @{ $pg->{fds} } ) or return;
+        my %counts;
+        @counts{ map { $pg->{by_id}{$_} } @{ $r->{ids} } } = @{ $r->{values} };
+        return \%counts, $r->{time_enabled}, $r->{time_running} if wantarray;
+        return \%counts;
+    }
+
+    # Count just the events that occur while running $code
+    sub measure {
+        my ($pg, $code) = @_;
+        $pg->reset or return;
+        $pg->enable or return;
+        $code->();
+        $pg->disable or return;
+        return $pg->read;
+    }
+
+    sub DESTROY {
+        my ($pg) = @_;
+        local $!;
+        POSIX::close($_) for reverse @{ $pg->{fds} };
+    }
 }
 
-_export_tag qw{ proc => wait4 } if _get_syscall_id 'wait4', 1;
-sub wait4($$) {
-    my ($cpid, $options) = @_;
-    my $status = pack 'I*', (0) x 1;
-    my $rusage = pack 'Q*', (0) x 18;
-    state $syscall_id = _get_syscall_id 'wait4';
-    $! = 0;
-    my $rpid = syscall $syscall_id,
-                       $cpid,
-                       $status,
-                       $options,
-                       $rusage;
-    warn sprintf "Invoked\tsyscall  %u WAIT4\n"
-                ."\targs     cpid=%d, options=%#x\n"
-                ."\treturned rpid=%d, status=(%s), rusage=(%s)\n"
-                ."\terrno    %s\n",
-                $syscall_id,
-                $cpid, $options,
-                $rpid, join(' ', unpack 'Q',$status), join(' ', unpack 'Q*', $rusage),
-                $!;
-    $rpid > 0 or return $rpid && ();    # 0->0, -1->empty
-    $status = unpack 'I', $status;
-    my ( $ru_utime, $ru_stime,
-         $ru_maxrss, $ru_ixrss, $ru_idrss, $ru_isrss,
-         $ru_minflt, $ru_majflt, $ru_nswap, $ru_inblock, $ru_oublock,
-         $ru_msgsnd, $ru_msgrcv, $ru_nsignals, $ru_nvcsw, $ru_nivcsw) = _unpack_rusage $rusage;
-    return $rpid,
-           $status,
-           $ru_utime, $ru_stime,
-           $ru_maxrss, $ru_ixrss, $ru_idrss, $ru_isrss,
-           $ru_minflt, $ru_majflt, $ru_nswap, $ru_inblock, $ru_oublock,
-           $ru_msgsnd, $ru_msgrcv, $ru_nsignals, $ru_nvcsw, $ru_nivcsw;
+_export_tag qw{ perf => perf_counters };
+sub perf_counters(@) {
+    return Linux::Syscalls::perf_group::->new(@_);
 }
 
-# waitpid2 is like the waitpid builtin, except that it returns the pid & status
-# instead of setting $?, and returns empty (and sets $!) on error.
+################################################################################
+#
+# io_uring - batches of asynchronous syscalls, submitted and completed through
+# a pair of rings shared with the kernel.
+#
+#   my $u = uring 128 or die "uring: $!";
+#   my %path_of = map { ( $u->statx(undef, $_) => $_ ) } @paths;
+#   for my $c ( $u->complete_all ) {
+#       printf "%s %d\n", $path_of{$c->{id}}, $c->{value}->size if ! $c->{errno};
+#   }
+#
+# Each queueing method (openat, statx, read, write, close, getdents, nop)
+# returns an ID. Nothing reaches the kernel until submit or complete, or the
+# submission ring fills up. complete waits for at least the given number of
+# completions (default 1), and returns all that are available, each a
+# hash-ref containing:
+#   id      as returned when the operation was queued
+#   op      the method name
+#   res     the raw result, negative on failure
+#   errno   (only on failure)
+#   value   (only on success) the fd from openat, a Linux::Syscalls::bless::stat
+#           from statx, the data from read, a list of Linux::Syscalls::bless::dirent
+#           from getdents, otherwise the same as res
+#
+# Operations in the same batch run concurrently and complete in any order, so
+# for example a read can't use the fd from an openat in the same batch.
+#
+# Mainline io_uring has no getdents operation, so getdents reads the whole
+# directory when it's queued, and its completion is simply held until the
+# next call to complete.
+#
+# Pure Perl can read the rings directly (with unpack "P"), but can only write
+# to them through a syscall (see _poke). So each io_uring_enter is preceded by
+# one process_vm_writev (or, failing that, a pwrite per write to
+# /proc/self/mem), which carries the SQEs, the new submission tail, and the
+# completion head; reaping completions costs no syscalls. As to memory
+# ordering: the kernel reads the submission tail only after the syscall that
+# wrote it has returned; but reading the completion tail and then the CQEs are
+# plain loads, which assumes a strongly ordered CPU (such as x86) whenever
+# complete is called without waiting.
+#
+# Constants from /usr/include/linux/io_uring.h; struct layouts from
+# Linux/unpacker/show_io_uring_struct.c
 
-_export_tag qw{ proc => waitpid2 } if _get_syscall_id 'waitpid', 1;
-sub waitpid2($$) {
-    my ($cpid, $options) = @_;
-    my $status = pack 'I*', (0) x 1;
-    state $syscall_id = _get_syscall_id 'waitpid';
-    $! = 0;
-    my $rpid = syscall $syscall_id,
-                       $cpid,
-                       $status,
-                       $options;
-    warn sprintf "Invoked\tsyscall  %u WAITPID\n"
-                ."\targs     cpid=%d, options=%#x\n"
-                ."\treturned rpid=%d, status=%s\n"
-                ."\terrno    %s\n",
-            $syscall_id, $cpid, $options, $rpid, unpack("H*",$status), $!;
-    $rpid > 0 or return $rpid && ();    # 0->0, -1->empty
-    $status = unpack 'I', $status;
-    return $rpid,
-           $status;
-}
+use constant {
+    IORING_SETUP_IOPOLL     => 0x01,
+    IORING_SETUP_SQPOLL     => 0x02,
+    IORING_SETUP_SQ_AFF     => 0x04,
+    IORING_SETUP_CQSIZE     => 0x08,
+    IORING_SETUP_CLAMP      => 0x10,
 
-# waitid returns a 5-element array
+    IORING_ENTER_GETEVENTS  => 0x01,
 
-_export_tag qw{ proc => waitid } if _get_syscall_id 'waitid', 1;
-sub waitid($$;$) {
-#   my ($id_type, $id, $options) = @_;
-    $_[2] //= WEXITED;
-    $_[3] = 0;
-    goto &waitid_;
+    IORING_FEAT_SINGLE_MMAP => 0x01,
+
+    IORING_OFF_SQ_RING      => 0,
+    IORING_OFF_CQ_RING      => 0x8000000,
+    IORING_OFF_SQES         => 0x10000000,
+
+    IORING_OP_NOP           => 0,
+    IORING_OP_OPENAT        => 18,
+    IORING_OP_CLOSE         => 19,
+    IORING_OP_STATX         => 21,
+    IORING_OP_READ          => 22,
+    IORING_OP_WRITE         => 23,
+
+    STATX_BASIC_STATS       => 0x7ff,
+};
+
+_export_tag qw{ uring =>
+    IORING_SETUP_IOPOLL IORING_SETUP_SQPOLL IORING_SETUP_SQ_AFF
+    IORING_SETUP_CQSIZE IORING_SETUP_CLAMP IORING_ENTER_GETEVENTS
+    STATX_BASIC_STATS
+};
+
+#     # struct io_uring_sqe {
+#  C  #     __u8  opcode;
+#  C  #     __u8  flags;            /* IOSQE_* */
+#  S  #     __u16 ioprio;
+#  l  #     __s32 fd;
+#  Q  #     __u64 off;              /* or addr2 */
+#  Q  #     __u64 addr;
+#  L  #     __u32 len;
+#  L  #     __u32 rw_flags;         /* or open_flags, statx_flags, ... */
+#  Q  #     __u64 user_data;
+#  S  #     __u16 buf_index;
+#  S  #     __u16 personality;
+#  l  #     __s32 splice_fd_in;
+#  Q  #     __u64 addr3;
+#x[Q] #     __u64 __pad2[1];
+#     # };
+#
+#     # struct io_uring_cqe {
+#  Q  #     __u64 user_data;
+#  l  #     __s32 res;
+#  L  #     __u32 flags;
+#     # };
+#
+#     # struct io_uring_params {
+#  L7 #     __u32 sq_entries, cq_entries, flags, sq_thread_cpu, sq_thread_idle, features, wq_fd;
+#x[L3]#     __u32 resv[3];
+#     #     struct io_sqring_offsets {
+#  L8 #         __u32 head, tail, ring_mask, ring_entries, flags, dropped, array, resv1;
+#  Q  #         __u64 resv2;
+#     #     } sq_off;
+#     #     struct io_cqring_offsets {
+#  L8 #         __u32 head, tail, ring_mask, ring_entries, overflow, cqes, flags, resv1;
+#  Q  #         __u64 resv2;
+#     #     } cq_off;
+#     # };
+#
+#     # struct statx {
+#  L  #     __u32 stx_mask;
+#  L  #     __u32 stx_blksize;
+#  Q  #     __u64 stx_attributes;
+#  L  #     __u32 stx_nlink;
+#  L  #     __u32 stx_uid;
+#  L  #     __u32 stx_gid;
+#  S  #     __u16 stx_mode;
+#x[S] #     __u16 __spare0[1];
+#  Q  #     __u64 stx_ino;
+#  Q  #     __u64 stx_size;
+#  Q  #     __u64 stx_blocks;
+#  Q  #     __u64 stx_attributes_mask;
+# qLx4#     struct statx_timestamp stx_atime, stx_btime, stx_ctime, stx_mtime;
+#  L4 #     __u32 stx_rdev_major, stx_rdev_minor, stx_dev_major, stx_dev_minor;
+#     #     ... (up to 256 bytes in all)
+#     # };
+
+use constant {
+    io_uring_sqe_packfmt    => 'CCSlQQLLQSSlQx[Q]',
+    io_uring_sqe_size       => 64,
+    io_uring_cqe_packfmt    => 'QlL',
+    io_uring_cqe_size       => 16,
+    io_uring_params_packfmt => 'L7x[L3](L8Q)2',
+    io_uring_params_size    => 120,
+    statx_packfmt           => 'LLQLLLSx[S]QQQQ(qLx4)4L4',
+};
+
+# io_uring_setup returns the ring's filedescriptor, and in list context also a
+# hash of the io_uring_params that the kernel filled in.
+
+_export_tag qw{ uring => io_uring_setup };
+sub io_uring_setup($;$) {
+    my ($entries, $flags) = @_;
+    my $params = "\0" x io_uring_params_size;
+    substr $params, 8, 4, pack 'L', $flags // 0;
+    state $syscall_id = _get_syscall_id 'io_uring_setup';
+    my $fd = syscall $syscall_id, $entries+0, $params;
+    return if $fd < 0;
+    $fd ||= zero_but_true;
+    return $fd if ! wantarray;
+    my @p = unpack io_uring_params_packfmt, $params;
+    my %p;
+    @p{qw( sq_entries cq_entries flags sq_thread_cpu sq_thread_idle features wq_fd )} = splice @p, 0, 7;
+    @{ $p{sq_off} }{qw( head tail ring_mask ring_entries flags dropped array resv1 resv2 )} = splice @p, 0, 9;
+    @{ $p{cq_off} }{qw( head tail ring_mask ring_entries overflow cqes flags resv1 resv2 )} = splice @p, 0, 9;
+    return $fd, \%p;
 }
 
-# waitid5 returns a 21-element array, starting with the same 5 as waitid
+_export_tag qw{ uring => io_uring_enter };
+sub io_uring_enter($$$;$) {
+    my ($fd, $to_submit, $min_complete, $flags) = @_;
+    _map_fd($fd) or return;
+    state $syscall_id = _get_syscall_id 'io_uring_enter';
+    my $r = syscall $syscall_id, $fd+0, $to_submit+0, $min_complete+0, ( $flags // 0 )+0, 0, 0;
+    return if $r < 0;
+    return $r || zero_but_true;
+}
 
-_export_tag qw{ proc => waitid5 } if _get_syscall_id 'waitid', 1;
-sub waitid5($$;$) {
-#   my ($id_type, $id, $options) = @_;
-    $_[2] //= WEXITED;
-    $_[3] = 1;
-    goto &waitid_;
+sub _unpack_statx($;$) {
+    my ($buffer, $time_format) = @_;
+    my ( undef, $blksize, undef, $nlink, $uid, $gid, $mode, $ino, $size, $blocks, undef,
+         $atime, $atime_ns, undef, undef, $ctime, $ctime_ns, $mtime, $mtime_ns,
+         $rdev_major, $rdev_minor, $dev_major, $dev_minor ) = unpack statx_packfmt, $buffer;
+    # Encode device numbers the same way as glibc's makedev
+    my ($dev, $rdev) = map {
+            my ($major, $minor) = @$_;
+            ( $major & 0xfff ) << 8 | ( $major & ~0xfff ) << 32 | $minor & 0xff | ( $minor & ~0xff ) << 12
+        } [ $dev_major, $dev_minor ], [ $rdev_major, $rdev_minor ];
+    return bless [
+            $dev, $ino, $mode, $nlink, $uid, $gid, $rdev, $size,
+            _timespec_as( $time_format, $atime, $atime_ns ),
+            _timespec_as( $time_format, $mtime, $mtime_ns ),
+            _timespec_as( $time_format, $ctime, $ctime_ns ),
+            $blksize, $blocks,
+            TIMERES_NANOSECOND,
+        ], Linux::Syscalls::bless::stat::;
 }
 
-# Assume that since you're calling waitid, you have an interest in the siginfo,
-# but since the rusage is a Linux syscall extension, only include it if you
-# explicitly ask for it.
-_export_ok 'waitid_' if _get_syscall_id 'waitid', 1;
-sub waitid_($$$;$$) {
-    my ($id_type, $id, $options, $record_wrusage, $record_siginfo) = @_;
-    $id_type |= 0;  # force numeric
-    $id |= 0;       # force numeric
-    $options |= 0;  # force numeric
-    my $siginfo = EMPTY_SIGINFO if $record_siginfo // 1 and wantarray;
-    my $wrusage = EMPTY_RUSAGE  if $record_wrusage // 0 and wantarray;
-    state $syscall_id = _get_syscall_id 'waitid';
-    $! = 0;
-    my $r = syscall $syscall_id,
-                    $id_type,
-                    $id,
-                    $siginfo // undef,
-                    $options,
-                    $wrusage // undef;
-    state $debug_waitid = $ENV{PERL5_DEBUG_WAITID};
-    warn sprintf "waitid_ invoked\n"
-                ."\tsyscall  %u\n"
-                ."\targs     type=%d, id=%d, options=%#x rec_si=%s rec_ru=%s\n"
-                ."\treturned result=%d si=%s rusage=%s\n"
-                ."\t\t errno %s (%d)\n",
-            $syscall_id,
-            $id_type,
-            $id,
-            $options,
-            $record_siginfo ? wantarray ? defined $record_siginfo ? 'record' : 'record-default' : 'omit-notwantarray' : 'omit',
-            $record_wrusage ? wantarray ? 'record' : 'omit-notwantarray' : defined $record_wrusage  ? 'omit' : 'omit-default',
-            $r,
-            defined $siginfo ? '<'.unpack('H*', $siginfo).'> ('.join(',', _unpack_siginfo $siginfo).')' : '(omitted)',
-            defined $wrusage ? '<'.unpack('H*', $wrusage).'> ('.join(',', _unpack_rusage  $wrusage).')' : '(omitted)',
-            $!, $!
-        if $^C || $debug_waitid;
-    $r == -1 and return;
+package Linux::Syscalls::uring {
+    # The address of a string's buffer, which stays put as long as the string
+    # isn't modified (or freed), so the caller must keep it in a pending record.
+    sub _addr_of { return unpack Linux::Syscalls::_ptr_packfmt, pack 'p', $_[0] }
 
-    # ignore si_errno, because it must be 0 if we get here.
-    my ($si_status, undef, $si_code, $si_pid, $si_uid, $si_signo, ) =
-    my @si = _unpack_siginfo $siginfo
-        if $record_siginfo && $r != -1;
+    my %decode = (
+        statx   => sub { Linux::Syscalls::_unpack_statx $_[0]->{buf}, $_[0]->{time_format} },
+        read    => sub { substr $_[0]->{buf}, 0, $_[1] },
+    );
 
-    return $si_pid if !wantarray;
+    sub new {
+        my ($class, $entries, $flags) = @_;
+        my ($fd, $p) = Linux::Syscalls::io_uring_setup( $entries // 128, $flags ) or return;
+        my $u = bless {
+            fd          => $fd,
+            sq_entries  => $p->{sq_entries},
+            cq_entries  => $p->{cq_entries},
+            batch       => '',
+            next_id     => 0,
+            pending     => {},
+            ready       => [],
+        }, $class;
+        my ($sq, $cq) = @$p{qw( sq_off cq_off )};
+        my $prot  = Linux::Syscalls::PROT_READ | Linux::Syscalls::PROT_WRITE;
+        my $share = Linux::Syscalls::MAP_SHARED | Linux::Syscalls::MAP_POPULATE;
+        $u->{sq_ring} = Linux::Syscalls::mmap( undef, $sq->{array} + 4 * $p->{sq_entries}, $prot, $share, $fd,
+                                               Linux::Syscalls::IORING_OFF_SQ_RING ) or return;
+        $u->{cq_ring} = Linux::Syscalls::mmap( undef, $cq->{cqes} + Linux::Syscalls::io_uring_cqe_size * $p->{cq_entries},
+                                               $prot, $share, $fd, Linux::Syscalls::IORING_OFF_CQ_RING ) or return;
+        $u->{sqes}    = Linux::Syscalls::mmap( undef, Linux::Syscalls::io_uring_sqe_size * $p->{sq_entries}, $prot, $share, $fd,
+                                               Linux::Syscalls::IORING_OFF_SQES ) or return;
+        my ($sa, $ca) = ( $u->{sq_ring}->addr, $u->{cq_ring}->addr );
+        @$u{qw( sq_head_addr sq_tail_addr sqes_addr )} = ( $sa + $sq->{head}, $sa + $sq->{tail}, $u->{sqes}->addr );
+        @$u{qw( cq_head_addr cq_tail_addr cqes_addr )} = ( $ca + $cq->{head}, $ca + $cq->{tail}, $ca + $cq->{cqes} );
+        $u->{sq_mask} = unpack 'L', Linux::Syscalls::_peek $sa + $sq->{ring_mask}, 4;
+        $u->{cq_mask} = unpack 'L', Linux::Syscalls::_peek $ca + $cq->{ring_mask}, 4;
+        $u->{sq_tail} = unpack 'L', Linux::Syscalls::_peek $u->{sq_tail_addr}, 4;
+        $u->{cq_head} = unpack 'L', Linux::Syscalls::_peek $u->{cq_head_addr}, 4;
+        # Slot i of the submission queue always holds SQE i, so the index
+        # array only needs filling in once.
+        Linux::Syscalls::_poke $sa + $sq->{array}, pack 'L*', 0 .. $p->{sq_entries} - 1 or return;
+        return $u;
+    }
 
-    my @wru = _unpack_rusage $wrusage
-        if defined $wrusage;
+    sub fd      { return $_[0]->{fd} }
+    sub entries { return $_[0]->{sq_entries} }
 
-    # Note pid & stat first, to be more consistent with other wait* calls
-    return $si_status, $si_code, $si_pid, $si_uid, $si_signo,
-           @wru;
-}
+    # Operations that have been queued but not yet returned by complete
+    sub pending { return scalar keys %{ $_[0]->{pending} } }
 
-################################################################################
+    sub _queue {
+        my ($u, $rec, $opcode, $fd, $off, $addr, $len, $op_flags) = @_;
+        # Keep the number in flight within the completion ring, so that it
+        # can't overflow
+        if ( keys %{ $u->{pending} } >= $u->{cq_entries} ) {
+            $u->_wait(1) or return;
+        } elsif ( length $u->{batch} >= Linux::Syscalls::io_uring_sqe_size * $u->{sq_entries} ) {
+            $u->submit or return;
+        }
+        my $id = ++$u->{next_id};
+        $u->{pending}{$id} = $rec;
+        $u->{batch} .= pack Linux::Syscalls::io_uring_sqe_packfmt,
+                            $opcode, 0, 0, $fd, $off, $addr, $len, $op_flags, $id, 0, 0, 0, 0;
+        return $id;
+    }
 
-# execveat like execve but takes fd+filepath+flags instead of filepath
-# (This is Linux-specific)
-_export_tag qw{ proc exec => execveat };
-sub execveat($$\@;\@$) {
-    my ($dir_fd, $path, $argv, $envp, $flags) = @_;
-    _resolve_dir_fd_path $dir_fd, $path, $flags or return;
-    $envp ||= [];
-    if (ref $envp eq 'HASH') {
-        $envp = [ map { ( $_ => $envp->{$_} ) } keys %$envp ];
+    sub nop {
+        my ($u) = @_;
+        return $u->_queue( { op => 'nop' }, Linux::Syscalls::IORING_OP_NOP, -1, 0, 0, 0, 0 );
     }
-    for my $p ( $argv, $envp ) {
-        $p = pack 'p*', @$p, undef;
+
+    # Arguments as for Linux::Syscalls::openat
+    sub openat {
+        my ($u, $dir_fd, $path, $flags, $mode) = @_;
+        Linux::Syscalls::_resolve_dir_fd_path( $dir_fd, $path ) or return;
+        my $rec = { op => 'openat', path => $path };
+        return $u->_queue( $rec, Linux::Syscalls::IORING_OP_OPENAT, $dir_fd, 0, _addr_of($rec->{path}),
+                           $mode // 0666, $flags // Linux::Syscalls::O_PATH );
+    }
+
+    # Arguments as for Linux::Syscalls::fstatat, plus the statx mask
+    sub statx {
+        my ($u, $dir_fd, $path, $flags, $time_format, $mask) = @_;
+        Linux::Syscalls::_resolve_dir_fd_path( $dir_fd, $path, $flags ) or return;
+        my $rec = { op => 'statx', path => $path, time_format => $time_format,
+                    buf => "\0" x Linux::Syscalls::statx_buffer_size };
+        return $u->_queue( $rec, Linux::Syscalls::IORING_OP_STATX, $dir_fd, _addr_of($rec->{buf}), _addr_of($rec->{path}),
+                           $mask // Linux::Syscalls::STATX_BASIC_STATS, $flags );
+    }
+
+    # Without an offset, read & write use (and update) the file position
+    sub read {
+        my ($u, $fd, $length, $offset) = @_;
+        Linux::Syscalls::_map_fd($fd) or return;
+        my $rec = { op => 'read', buf => "\0" x $length };
+        return $u->_queue( $rec, Linux::Syscalls::IORING_OP_READ, $fd, $offset // -1, _addr_of($rec->{buf}), $length, 0 );
+    }
+
+    sub write {
+        my ($u, $fd, $data, $offset) = @_;
+        Linux::Syscalls::_map_fd($fd) or return;
+        my $rec = { op => 'write', buf => "$data" };
+        return $u->_queue( $rec, Linux::Syscalls::IORING_OP_WRITE, $fd, $offset // -1, _addr_of($rec->{buf}),
+                           length $rec->{buf}, 0 );
+    }
+
+    sub close {
+        my ($u, $fd) = @_;
+        Linux::Syscalls::_map_fd($fd) or return;
+        return $u->_queue( { op => 'close' }, Linux::Syscalls::IORING_OP_CLOSE, $fd, 0, 0, 0, 0 );
+    }
+
+    sub getdents {
+        my ($u, $fd, $bufsize) = @_;
+        my @entries;
+        $! = 0;
+        while ( my @e = Linux::Syscalls::getdents( $fd, $bufsize ) ) {
+            defined $e[0] or last;
+            push @entries, @e;
+        }
+        my $id = ++$u->{next_id};
+        push @{ $u->{ready} }, { id => $id, op => 'getdents',
+                                 $! ? ( res => -$!, errno => $!+0 ) : ( res => scalar @entries, value => \@entries ) };
+        return $id;
+    }
+
+    # Copy the batch into the submission ring and tell the kernel about it,
+    # optionally waiting for $min_complete completions. Returns the number
+    # submitted.
+    sub _enter {
+        my ($u, $min_complete) = @_;
+        my $n = length( $u->{batch} ) / Linux::Syscalls::io_uring_sqe_size;
+        # All the writes to the rings go in one _pokev: first the completion
+        # head left over from _reap, then the SQEs, then the submission tail.
+        my @writes;
+        push @writes, $u->{cq_head_addr}, pack 'L', $u->{cq_head} if delete $u->{cq_head_dirty};
+        if ($n) {
+            my $slot = $u->{sq_tail} & $u->{sq_mask};
+            my $first = $u->{sq_entries} - $slot;
+            $first = $n if $first > $n;
+            push @writes, $u->{sqes_addr} + Linux::Syscalls::io_uring_sqe_size * $slot,
+                          substr $u->{batch}, 0, Linux::Syscalls::io_uring_sqe_size * $first;
+            push @writes, $u->{sqes_addr}, substr $u->{batch}, Linux::Syscalls::io_uring_sqe_size * $first
+                if $n > $first;
+            $u->{batch} = '';
+            $u->{sq_tail} = ( $u->{sq_tail} + $n ) & 0xffffffff;
+            push @writes, $u->{sq_tail_addr}, pack 'L', $u->{sq_tail};
+        }
+        if (@writes) {
+            if ( ! Linux::Syscalls::_pokev @writes ) {
+                $u->{cq_head_dirty} = 1;
+                return;
+            }
+        }
+        my $submitted = 0;
+        for (;;) {
+            # Count what the kernel hasn't yet consumed, in case an earlier
+            # call was interrupted part-way
+            my $to_submit = ( $u->{sq_tail} - unpack 'L', Linux::Syscalls::_peek $u->{sq_head_addr}, 4 ) & 0xffffffff;
+            $to_submit || $min_complete or last;
+            my $r = Linux::Syscalls::io_uring_enter( $u->{fd}, $to_submit, $min_complete // 0,
+                                                     $min_complete ? Linux::Syscalls::IORING_ENTER_GETEVENTS : 0 );
+            if ( ! defined $r ) {
+                $!{EINTR} or return;
+                next;
+            }
+            $submitted += $r;
+            last;
+        }
+        return $submitted || Linux::Syscalls::zero_but_true;
+    }
+
+    sub submit {
+        my ($u) = @_;
+        return $u->_enter(0);
+    }
+
+    # Move everything from the completion ring onto the ready list
+    sub _reap {
+        my ($u) = @_;
+        my $tail = unpack 'L', Linux::Syscalls::_peek $u->{cq_tail_addr}, 4;
+        my $n = ( $tail - $u->{cq_head} ) & 0xffffffff or return 0;
+        my $slot = $u->{cq_head} & $u->{cq_mask};
+        my $first = $u->{cq_entries} - $slot;
+        $first = $n if $first > $n;
+        my $cqes = Linux::Syscalls::_peek $u->{cqes_addr} + Linux::Syscalls::io_uring_cqe_size * $slot,
+                                          Linux::Syscalls::io_uring_cqe_size * $first;
+        $cqes .= Linux::Syscalls::_peek $u->{cqes_addr}, Linux::Syscalls::io_uring_cqe_size * ( $n - $first ) if $n > $first;
+        # The kernel only needs the new head before it can post more
+        # completions, which can't happen until more is submitted; so leave
+        # it for the next _enter to write along with everything else.
+        $u->{cq_head} = $tail;
+        $u->{cq_head_dirty} = 1;
+        my @cqes = unpack '(' . Linux::Syscalls::io_uring_cqe_packfmt . ")$n", $cqes;
+        while ( my ($id, $res) = splice @cqes, 0, 3 ) {
+            my $rec = delete $u->{pending}{$id} or next;
+            my %c = ( id => $id, op => $rec->{op}, res => $res );
+            if ( $res < 0 ) {
+                $c{errno} = -$res;
+            } else {
+                my $d = $decode{ $rec->{op} };
+                $c{value} = $d ? $d->( $rec, $res ) : $res;
+            }
+            push @{ $u->{ready} }, \%c;
+        }
+        return $n;
+    }
+
+    sub _wait {
+        my ($u, $min) = @_;
+        my $want = @{ $u->{ready} } + $min;
+        while ( @{ $u->{ready} } < $want ) {
+            $u->_enter( $want - @{ $u->{ready} } ) or return;
+            $u->_reap // return;
+        }
+        return 1;
+    }
+
+    # Submit anything queued, wait for at least $min more operations to
+    # complete (capped at the number outstanding), and return every completion
+    # that's available.
+    sub complete {
+        my ($u, $min) = @_;
+        my $outstanding = keys %{ $u->{pending} };
+        $min //= @{ $u->{ready} } ? 0 : 1;
+        $min = $outstanding if $min > $outstanding;
+        $u->_wait($min) or return;
+        $u->_reap // return;
+        return splice @{ $u->{ready} };
+    }
+
+    sub complete_all {
+        my ($u) = @_;
+        return $u->complete( scalar keys %{ $u->{pending} } );
+    }
+
+    sub DESTROY {
+        my ($u) = @_;
+        local $!;
+        # The kernel may still be writing into buffers held by pending records
+        $u->complete_all if $u->{sqes} && %{ $u->{pending} };
+        Linux::Syscalls::closefd $u->{fd};
     }
-    state $syscall_id = _get_syscall_id 'execveat';
-    my $r = syscall $syscall_id,
-                    $dir_fd,
-                    $path,
-                    $argv,
-                    $envp,
-                    $flags;
-    $r == -1 and return;
-    return $r;
 }
 
-# fexecve can be implemented either using execveat or /proc/$pid/fd/$fd
-_export_tag qw{ proc exec => fexecve };
-sub fexecve($\@;\@) {
-    splice @_, 1, 0, undef;     # empty path
-    goto &execveat;
+_export_tag qw{ uring => uring };
+sub uring(;$$) {
+    return Linux::Syscalls::uring::->new(@_);
 }
 
 ################################################################################
@@ -456,9 +456,12 @@ our %syscall_map = (
         memfd_secret            => 447,
 #endif
         process_mrelease        => 448,
+        futex_waitv             => 449,
+        set_mempolicy_home_node => 450,
+        cachestat               => 451,
 
         # Last+1
-        __NR_syscalls           => 449,
+        __NR_syscalls           => 452,
 
         #
         # Linux porting guidelines suggest that all the following syscalls
@@ -536,6 +539,8 @@ our %pack_map = (
     time_t   => 'q',
     timespec => 'qLx![q]',
     timeval  => 'qLx![q]',
+
+    epoll_event => 'Lx![Q]Q',   # events, data
 );
 
 our @EXPORT_OK = qw(
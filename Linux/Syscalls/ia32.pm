@@ -508,6 +508,8 @@ our %pack_map = (
         timespec => 'LL',   # seconds, nanoseconds
         timeval  => 'LL',   # seconds, microseconds
 
+        epoll_event => 'LQ',    # events, data (u64 only 4-aligned)
+
 );
 
 our @EXPORT = qw(
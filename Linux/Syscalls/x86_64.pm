@@ -400,6 +400,9 @@ our %syscall_map = (
         landlock_restrict_self  => 446,
         memfd_secret            => 447,
         process_mrelease        => 448,
+        futex_waitv             => 449,
+        set_mempolicy_home_node => 450,
+        cachestat               => 451,
 
 );
 
@@ -419,6 +422,8 @@ our %pack_map = (
     time_t       => 'q',          # seconds
     timespec     => 'qLx![q]',    # seconds, nanoseconds
     timeval      => 'qLx![q]',    # seconds, microseconds
+
+    epoll_event  => 'LQ',         # events, data (packed, even for x32)
 );
 
 if ( $x32 ) {
@@ -0,0 +1,57 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use POSIX ();
+use Time::Nanosecond ();
+use Linux::Syscalls qw( :_at :time_ :proc statns fstatns );
+
+my $file = "/tmp/syscalls-stattime-$$";
+open my $fh, '>', $file or die "Can't create $file; $!";
+END { unlink $file if defined $file }
+
+for my $t (
+    sub {
+        # A timestamp that can't be held exactly in a double
+        my ($s, $ns) = ( 1_700_000_000, 123_456_789 );
+        utimensat undef, $file, Time::Nanosecond::new_timespec($s, $ns), Time::Nanosecond::new_timespec($s, $ns+1)
+            or die "utimensat failed; $!";
+        my @st = statns $file, TIME_PAIR or die "statns failed; $!";
+        my ($atime, $mtime) = @st[8, 9];
+        "@$atime" eq "$s $ns" && "@$mtime" eq "$s ".($ns+1) or die "Wrong pairs (@$atime) (@$mtime)";
+
+        my $st = fstatat undef, $file, 0, TIME_NS or die "fstatat failed; $!";
+        $st->mtime->isa('Time::Nanosecond::ns') or die "Expected Time::Nanosecond::ns, got ".ref $st->mtime;
+        $st->mtime->nanoseconds == $s * 1_000_000_000 + $ns + 1 or die "Wrong mtime ".$st->mtime->nanoseconds;
+        $st->mtime != $st->atime or die "Expected atime & mtime to differ";
+
+        my @fst = fstatns $fh, TIME_NS or die "fstatns failed; $!";
+        $fst[9] == $st->mtime or die "fstatns and fstatat disagree";
+        my @float = statns $file;
+        !ref $float[9] || $float[9]->isa('Time::Nanosecond::ts') or die "Expected default format to be unchanged";
+    },
+    sub {
+        my $pid = fork // die "Can't fork; $!";
+        if (!$pid) {
+            my $x = 0;
+            $x += $_ for 1 .. 200_000;
+            POSIX::_exit(0);
+        }
+        my ($rpid, $status, $utime, $stime, $maxrss) = wait4 $pid, 0, TIME_PAIR;
+        $rpid == $pid && $status == 0 or die "wait4 failed; $!";
+        ref $utime eq 'ARRAY' && ref $stime eq 'ARRAY' or die "Expected pairs";
+        $utime->[1] % 1000 == 0 && $utime->[1] < 1_000_000_000 or die "Expected whole microseconds as nanoseconds, got $utime->[1]";
+        $maxrss > 0 or die "Wrong maxrss $maxrss";
+        my @ru = Linux::Syscalls::_unpack_rusage pack('Q18', 3, 250_000, 0, 1, (7) x 14), TIME_NS;
+        $ru[0]->nanoseconds == 3_250_000_000 && $ru[1]->nanoseconds == 1000 && $ru[2] == 7 or die "Wrong rusage (@ru[0..2])";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,74 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use Linux::Syscalls qw( :proc :poll );
+
+sub spawn_exit($$) {
+    my ($delay, $status) = @_;
+    my $pid = fork // die "Can't fork; $!";
+    if (!$pid) {
+        select undef, undef, undef, $delay;
+        POSIX::_exit($status);
+    }
+    return $pid;
+}
+
+for my $t (
+    sub {
+        my $pid = spawn_exit 0, 7;
+        my ($si_status, $si_code, $si_pid, $si_uid, $si_signo) = waitid P_PID, $pid, WEXITED or die "waitid failed; $!";
+        $si_pid == $pid        or die "Wrong pid $si_pid, expected $pid";
+        $si_status == 7        or die "Wrong status $si_status";
+        $si_code == CLD_EXITED or die "Wrong code $si_code";
+        $si_signo == 17        or die "Wrong signo $si_signo";
+    },
+    sub {
+        my $w = child_watcher;
+        my %want;
+        for my $status (3, 4, 5) {
+            my $pid = spawn_exit 0.05 * $status, $status;
+            $w->add($pid) or die "Can't watch $pid; $!";
+            $want{$pid} = $status;
+        }
+        $w->count == 3 or die "Expected 3 watched children";
+        while ($w->count) {
+            my @r = $w->wait(5) or die "wait failed; $!";
+            for my $r (@r) {
+                my ($pid, $si, $ru) = @$r;
+                $si->[3] == $pid           or die "Wrong pid in siginfo";
+                $si->[5] == $want{$pid}    or die "Wrong status for $pid";
+                @$ru == 16                 or die "Wrong rusage size";
+                delete $want{$pid};
+            }
+        }
+        %want and die "Children not reaped: @{[ keys %want ]}";
+    },
+    sub {
+        my %want = map { ( spawn_exit(0, $_) => $_ ) } 10 .. 29;
+        my @r;
+        while (%want) {
+            select undef, undef, undef, 0.05;
+            for my $r ( reap_all 0, qw( maxrss utime ) ) {
+                my ($pid, $si_status, $si_code, $si_uid, $maxrss, $utime) = @$r;
+                exists $want{$pid}          or die "Unexpected child $pid";
+                $si_status == $want{$pid}   or die "Wrong status for $pid";
+                $si_code == CLD_EXITED      or die "Wrong code for $pid";
+                $maxrss > 0                 or die "Missing maxrss for $pid";
+                defined $utime              or die "Missing utime for $pid";
+                delete $want{$pid};
+            }
+        }
+        reap_all and die "Reaped a child that doesn't exist";
+        $! == POSIX::ECHILD or die "Expected ECHILD, got $!";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,87 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use Fcntl ();
+use POSIX ();
+use Linux::Syscalls qw( :proc :exec :poll );
+
+sub slurp($) {
+    my ($fh) = @_;
+    local $/;
+    return scalar <$fh>;
+}
+
+for my $t (
+    sub {
+        pipe my $r, my $w or die "pipe failed; $!";
+        opendir my $d, '/' or die "opendir failed; $!";
+        my ($pidfd, $pid) = spawn '/bin/sh', [ 'sh', '-c', 'echo "$FOO $(pwd)" >&2; ls /proc/self/fd' ], {
+            fds       => { 1 => $w, 2 => $w },
+            env       => { FOO => 'foo' },
+            cwd       => $d,
+            close_fds => 1,
+        } or die "spawn failed; $!";
+        close $w;
+        my $out = slurp $r;
+        my ($line, @fds) = split /\n/, $out;
+        $line eq 'foo /' or die "Expected env & cwd to be set, got '$line'";
+        # ls itself holds one more open
+        @fds <= 4 or die "Expected only 0..2 to be inherited, got (@fds)";
+        my %ready = ppoll { $pidfd => POLLIN }, 5;
+        $ready{$pidfd} or die "pidfd not readable after child exited";
+        waitpid $pid, 0;
+        $? == 0 or die "Child failed with $?";
+        POSIX::close($pidfd);
+    },
+    sub {
+        pipe my $ra, my $wa or die "pipe failed; $!";
+        pipe my $rb, my $wb or die "pipe failed; $!";
+        my ($fa, $fb) = ( fileno $wa, fileno $wb );
+        # Swap the two write ends
+        my ($pidfd, $pid) = spawn '/bin/sh', [ 'sh', '-c', "echo a >&$fa; echo b >&$fb" ], {
+            fds => { $fa => $wb, $fb => $wa },
+        } or die "spawn failed; $!";
+        close $wa;
+        close $wb;
+        my ($out_a, $out_b) = ( slurp $ra, slurp $rb );
+        $out_a eq "b\n" && $out_b eq "a\n" or die "Expected swapped output, got '$out_a' & '$out_b'";
+        my $w8 = child_watcher;
+        $w8->add_pidfd($pidfd, $pid);
+        my @r = $w8->wait(5);
+        @r == 1 && $r[0][1][5] == 0 or die "Child failed";
+    },
+    sub {
+        # POSIX::open doesn't set close-on-exec, unlike Perl's open
+        my @fds = sort { $a <=> $b } map { POSIX::open('/dev/null') // die "open failed; $!" } 1 .. 5;
+        my %open = map { ( $_ => 1 ) } Linux::Syscalls::_open_fds();
+        $open{$_} or die "Expected fd $_ in /proc/self/fd" for @fds;
+
+        close_range $fds[0], $fds[1], CLOSE_RANGE_CLOEXEC or die "close_range(CLOEXEC) failed; $!";
+        for my $i (0 .. 2) {
+            my $flags = Linux::Syscalls::_fd_syscall fcntl => $fds[$i], Fcntl::F_GETFD(), 0;
+            ( $flags & Fcntl::FD_CLOEXEC() ? 1 : 0 ) == ( $i < 2 ? 1 : 0 )
+                or die "Wrong close-on-exec flag for fd $fds[$i]";
+        }
+
+        close_range $fds[2] or die "close_range failed; $!";
+        %open = map { ( $_ => 1 ) } Linux::Syscalls::_open_fds();
+        $open{$_} and die "Expected fd $_ to be closed" for @fds[2 .. 4];
+        $open{$_} or die "Expected fd $_ to be open" for @fds[0, 1];
+        POSIX::close($_) for @fds[0, 1];
+    },
+    sub {
+        my @r = spawn '/nonexistent/program', [ 'x' ];
+        !@r && $!{ENOENT} or die "Expected ENOENT, got (@r); $!";
+        reap_all and die "Failed child left unreaped";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,67 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use POSIX ();
+use Linux::Syscalls qw( :proc );
+
+sub spawn_busy($) {
+    my ($loops) = @_;
+    my $pid = fork // die "Can't fork; $!";
+    if (!$pid) {
+        my $x = 0;
+        $x += $_ for 1 .. $loops;
+        POSIX::_exit($x ? 0 : 1);
+    }
+    return $pid;
+}
+
+for my $t (
+    sub {
+        my $prof = child_profiler;
+        $prof->start( spawn_busy(1),         'idle' ) for 1 .. 3;
+        $prof->start( spawn_busy(2_000_000), 'busy' ) for 1 .. 2;
+        my $n = 0;
+        $n += $prof->collect(0) while $prof->running;
+        $n == 5 or die "Expected to collect 5 children, got $n";
+
+        my @records = $prof->records;
+        for my $r (@records) {
+            $r->{status} == 0 or die "Child $r->{pid} failed";
+            $r->{start}->isa('Time::Nanosecond::ts') or die "Expected Time::Nanosecond start";
+            $r->{end} >= $r->{start} or die "End before start";
+            $r->{maxrss} > 0 or die "Missing maxrss";
+        }
+
+        my %rows = map { ( "$_->[0] $_->[1]" => $_ ) } $prof->summary(qw( cpu wall maxrss ));
+        keys %rows == 6 or die "Expected 2 labels x 3 metrics";
+        $rows{'busy cpu'}[2] == 2 && $rows{'idle cpu'}[2] == 3 or die "Wrong counts";
+        $rows{'busy cpu'}[3] > $rows{'idle cpu'}[3] or die "Expected busy children to use more CPU";
+        my (undef, undef, undef, $total, $p50, $p90, $p99, $max) = @{ $rows{'busy wall'} };
+        $p50 <= $p90 && $p90 <= $p99 && $p99 <= $max && $max <= $total or die "Percentiles out of order";
+
+        my $table = $prof->table;
+        $table =~ /^label\s+metric\s+count/ or die "Missing table header";
+        $table =~ /^busy\s+maxrss\s+2\s/m or die "Missing table row:\n$table";
+    },
+    sub {
+        my $prof = child_profiler;
+        my $pid = $prof->start( spawn_busy(1), 'handed' );
+        my $w = child_watcher;
+        $w->add($pid) or die "child_watcher->add failed; $!";
+        my ($r) = $w->wait(5) or die "Child didn't finish";
+        $prof->finish( $r->[0], $r->[1][5], @{ $r->[2] } ) or die "finish failed";
+        my ($rec) = $prof->records;
+        $rec->{label} eq 'handed' && $rec->{pid} == $pid or die "Wrong record";
+        !$prof->running or die "Expected nothing left running";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
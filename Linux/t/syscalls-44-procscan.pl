@@ -0,0 +1,53 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use POSIX ();
+use Linux::Syscalls qw( :proc );
+
+for my $t (
+    sub {
+        my @procs = proc_scan or die "proc_scan failed; $!";
+        my ($me) = grep { $_->pid == $$ } @procs or die "Didn't find self in process table";
+        $me->ppid == getppid    or die "Wrong ppid ".$me->ppid;
+        $me->state eq 'R'       or die "Expected to be running, got ".$me->state;
+        $me->num_threads >= 1   or die "Wrong thread count";
+        $me->resident > 0       or die "Missing statm";
+        $me->rss_kib > 0        or die "Missing rss";
+        defined $me->pidfd      and die "Unexpected pidfd";
+        # Check a comm containing a space and a parenthesis
+        my $pid = fork // die "Can't fork; $!";
+        if (!$pid) {
+            $0 = 'odd (name';
+            sleep 10;
+            POSIX::_exit(0);
+        }
+        for my $try (1 .. 50) {
+            my ($kid) = grep { $_->pid == $pid } proc_scan { statm => 0 };
+            if ( $kid && $kid->comm eq 'odd (name' ) {
+                $kid->ppid == $$ or die "Wrong ppid for child";
+                last;
+            }
+            $try < 50 or die "Didn't find renamed child";
+            select undef, undef, undef, 0.02;
+        }
+        kill KILL => $pid;
+        waitpid $pid, 0;
+    },
+    sub {
+        my @procs = proc_scan { pidfd => 1 };
+        my ($me) = grep { $_->pid == $$ } @procs or die "Didn't find self in process table";
+        defined $me->pidfd or die "Missing pidfd";
+        readlink "/proc/self/fd/".$me->pidfd eq 'anon_inode:[pidfd]' or die "Not a pidfd";
+        defined $_->pidfd and POSIX::close($_->pidfd) for @procs;
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
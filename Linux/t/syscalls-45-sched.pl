@@ -0,0 +1,55 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use POSIX ();
+use Linux::Syscalls qw( :sched );
+
+my @allowed = sched_getaffinity;
+
+for my $t (
+    sub {
+        @allowed or die "sched_getaffinity failed; $!";
+        my $bits = sched_getaffinity;
+        my @from_bits = grep { vec $bits, $_, 1 } 0 .. 8 * length($bits) - 1;
+        "@from_bits" eq "@allowed" or die "Bit-string (@from_bits) doesn't match list (@allowed)";
+        my ($cpu, $node) = getcpu;
+        defined $node or die "getcpu failed; $!";
+        grep { $_ == $cpu } @allowed or die "Running on CPU $cpu, outside (@allowed)";
+    },
+    sub {
+        my $pid = fork // die "Can't fork; $!";
+        if (!$pid) {
+            my @cpus = pin_round_robin 0, 1;
+            my @now = sched_getaffinity;
+            POSIX::_exit( @cpus == 1 && "@now" eq "@cpus" && $cpus[0] == $allowed[ 1 % @allowed ] ? 0 : 1 );
+        }
+        waitpid $pid, 0;
+        $? == 0 or die "Child wasn't pinned";
+        my @node_cpus = pin_round_robin $$, 0, 'node' or die "pin_round_robin by node failed; $!";
+        my $nodes = numa_node_cpus;
+        my ($first) = sort { $a <=> $b } keys %$nodes;
+        my %on_node = map { ( $_ => 1 ) } @{ $nodes->{$first} };
+        !grep { !$on_node{$_} } @node_cpus or die "Pinned outside node $first";
+        sched_setaffinity 0, \@allowed or die "sched_setaffinity failed; $!";
+    },
+    sub {
+        my $pid = fork // die "Can't fork; $!";
+        if (!$pid) {
+            sched_setattr 0, { policy => SCHED_BATCH, nice => 5 } or POSIX::_exit(1);
+            my $attr = sched_getattr or POSIX::_exit(2);
+            POSIX::_exit( $attr->{policy} == SCHED_BATCH && $attr->{nice} == 5 ? 0 : 3 );
+        }
+        waitpid $pid, 0;
+        $? == 0 or die "sched_setattr/sched_getattr failed in child (".($? >> 8).")";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
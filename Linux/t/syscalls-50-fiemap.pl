@@ -0,0 +1,86 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use File::Temp qw( tempdir );
+
+use Linux::Syscalls qw( :fiemap );
+
+my $dir = tempdir CLEANUP => 1;
+
+sub make_file($@) {
+    my ($name, @pieces) = @_;
+    my $path = "$dir/$name";
+    open my $fh, '>:raw', $path or die "Can't create $path; $!";
+    while (my ($offset, $data) = splice @pieces, 0, 2) {
+        sysseek $fh, $offset, 0 or die "Can't seek $path; $!";
+        syswrite $fh, $data or die "Can't write $path; $!";
+    }
+    close $fh or die "Can't close $path; $!";
+    return $path;
+}
+
+sub slurp($) {
+    open my $fh, '<:raw', $_[0] or die "Can't open $_[0]; $!";
+    local $/;
+    return scalar <$fh>;
+}
+
+for my $t (
+    sub {
+        exists &fiemap_read or die "Missing &fiemap_read";
+    },
+    sub {
+        my @files = (
+            make_file( 'dense',  0 => join '', map { chr(32 + $_ % 95) } 0 .. 99_999 ),
+            make_file( 'sparse', 0 => 'head', 3 << 20 => 'tail' ),
+            make_file( 'empty' ),
+        );
+        my %got;
+        my $n = fiemap_read @files, sub {
+            my ($file, $offset, $data) = @_;
+            my $s = \( $got{$file} //= '' );
+            $$s .= "\0" x ( $offset - length $$s ) if $offset > length $$s;
+            substr( $$s, $offset, length $data ) = $data;
+            1;
+        }, 4096 or die "fiemap_read failed; $!";
+        for my $file (@files) {
+            my $want = slurp $file;
+            my $have = $got{$file} // '';
+            # Holes are skipped, so pad out to the file's length
+            $have .= "\0" x ( length($want) - length($have) );
+            $have eq $want or die "Content mismatch for $file";
+        }
+        warn "Read $n bytes\n";
+        1;
+    },
+    sub {
+        my @files = ( make_file( 'abort', 0 => 'x' x 10_000 ) );
+        my $calls = 0;
+        fiemap_read @files, sub { ++$calls; 0 }, 1000 or die "fiemap_read failed; $!";
+        $calls == 1 or die "Expected callback to abort after 1 call, got $calls";
+    },
+    sub {
+        # tmpfs has no fiemap, so the whole file is read as one unmapped extent
+        -d '/dev/shm' or return 1;
+        my $dir = tempdir DIR => '/dev/shm', CLEANUP => 1;
+        my $path = "$dir/unmapped";
+        open my $fh, '>:raw', $path or die "Can't create $path; $!";
+        syswrite $fh, 'y' x 10_000 or die "Can't write $path; $!";
+        close $fh or die "Can't close $path; $!";
+        my @files = $path;
+        my $got = '';
+        my $n = fiemap_read @files, sub { $got .= $_[2]; 1 }, 4096 or die "fiemap_read failed; $!";
+        $n == 10_000 or die "Expected 10000 bytes, got $n";
+        $got eq 'y' x 10_000 or die "Content mismatch for $path";
+    },
+) {
+    eval { $t->(); } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,51 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use File::Temp qw( tempdir );
+
+use Linux::Syscalls qw( :seek :pio );
+
+my $dir = tempdir CLEANUP => 1;
+
+my $mib = 1 << 20;
+
+for my $t (
+    sub {
+        exists &data_regions or die "Missing &data_regions";
+        exists &copy_sparse  or die "Missing &copy_sparse";
+    },
+    sub {
+        open my $in, '+>:raw', "$dir/in" or die "Can't create $dir/in; $!";
+        pwrite $in, 'head', 0        or die "pwrite failed; $!";
+        pwrite $in, 'middle', 5*$mib or die "pwrite failed; $!";
+        ftruncate $in, 12*$mib       or die "ftruncate failed; $!";
+
+        my @regions;
+        my $it = data_regions $in or die "data_regions failed; $!";
+        while ( my @r = $it->() ) { push @regions, \@r }
+        $! and die "data_regions iteration failed; $!";
+        @regions == 2 or warn "Filesystem reports @{[ scalar @regions ]} data regions\n";
+        $regions[0][0] == 0 or die "First data region should start at 0";
+
+        open my $out, '+>:raw', "$dir/out" or die "Can't create $dir/out; $!";
+        sysseek $in, 3, 0 or die "sysseek failed; $!";
+        my $n = copy_sparse $in, $out or die "copy_sparse failed; $!";
+        sysseek( $in, 0, 1 ) == 3 or die "copy_sparse moved the input file position";
+        $n < 12*$mib or warn "Holes were copied\n";
+        -s $out == 12*$mib or die "Output has wrong size";
+        pread($out, 4, 0) eq 'head' or die "Wrong data at start";
+        pread($out, 6, 5*$mib) eq 'middle' or die "Wrong data in middle";
+        pread($out, 4, 8*$mib) eq "\0" x 4 or die "Hole not preserved";
+        pread($out, 1, 12*$mib) eq '' or die "Expected EOF";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,83 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use File::Temp qw( tempdir );
+use Fcntl qw( O_RDWR O_CREAT );
+use POSIX ();
+
+use Linux::Syscalls qw( :mman :dio );
+
+my $dir = tempdir CLEANUP => 1;
+
+my $page = 4096;
+
+for my $t (
+    sub {
+        my $m = mmap_file __FILE__ or die "mmap_file failed; $!";
+        $m->length == -s __FILE__ or die "Mapping has wrong length";
+        $m->peek(0, 2) eq '#!' or die "Mapping has wrong content";
+        $m->madvise(MADV_SEQUENTIAL) or die "madvise failed; $!";
+        defined $m->poke(0, 'x') and die "Wrote to a read-only mapping";
+        $! == POSIX::EACCES or die "Expected EACCES from poke, got $!";
+    },
+    sub {
+        # Unmapping through the function must stop DESTROY unmapping again
+        my $m = mmap undef, $page, PROT_READ|PROT_WRITE, MAP_PRIVATE or die "mmap failed; $!";
+        my $addr = $m->addr;
+        munmap $m or die "munmap failed; $!";
+        defined $m->addr and die "Still mapped after munmap";
+        my $n = mmap $addr, $page, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED or die "mmap failed; $!";
+        undef $m;
+        $n->poke(0, 'live') or die "poke failed; $!";
+        $n->peek(0, 4) eq 'live' or die "Reused mapping lost its content";
+    },
+    sub {
+        open my $fh, '<:raw', __FILE__ or die "Can't open @{[__FILE__]}; $!";
+        sysseek $fh, 2, 0 or die "sysseek failed; $!";
+        my $m = mmap_file $fh or die "mmap_file failed; $!";
+        $m->length == -s $fh or die "Mapping has wrong length";
+        sysseek( $fh, 0, 1 ) == 2 or die "mmap_file moved the file position";
+        defined mmap_file( $fh, PROT_READ, MAP_SHARED, 1, 1 ) and die "Mapped at an unaligned offset";
+    },
+    sub {
+        my $m = mmap undef, 2*$page, PROT_READ|PROT_WRITE, MAP_PRIVATE or die "mmap failed; $!";
+        $m->peek($page, 4) eq "\0" x 4 or die "Anonymous mapping not zeroed";
+        $m->poke($page-2, 'span') == 4 or die "poke failed; $!";
+        $m->peek($page-2, 4) eq 'span' or die "poke didn't stick";
+        defined $m->peek(2*$page-1, 2) and die "Read beyond end of mapping";
+        $m->mremap(4*$page) or die "mremap failed; $!";
+        $m->peek($page-2, 4) eq 'span' or die "Content lost by mremap";
+        $m->msync(MS_SYNC) or die "msync failed; $!";
+        $m->munmap or die "munmap failed; $!";
+        defined $m->addr and die "Still mapped after munmap";
+    },
+    sub {
+        my $buf = aligned_buffer 3*$page or die "aligned_buffer failed; $!";
+        $buf->addr % $page == 0 or die "Buffer is not page-aligned";
+        sysopen my $fh, "$dir/direct", O_RDWR|O_CREAT|O_DIRECT or do {
+            warn "Skipping O_DIRECT test; $!\n";
+            return 1;
+        };
+        my ($mem_align, $offset_align) = dio_alignment $fh or do {
+            warn "Skipping O_DIRECT test; $!\n";
+            return 1;
+        };
+        $buf->poke(0, 'direct' x $page);
+        pwrite_aligned($fh, $buf, 2*$page, 0) == 2*$page or die "pwrite_aligned failed; $!";
+        defined pwrite_aligned($fh, $buf, $offset_align-1, 0) and die "Misaligned length accepted";
+        defined pread_aligned($fh, $buf, $page, 1) and die "Misaligned offset accepted";
+        defined pread_aligned($fh, $buf, $page, 0, 3*$page) and die "Read beyond end of buffer";
+        pread_aligned($fh, $buf, $page, $page, 2*$page) == $page or die "pread_aligned failed; $!";
+        $buf->peek(2*$page, $page) eq $buf->peek($page, $page) or die "Read back wrong data";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,42 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use POSIX ();
+use Linux::Syscalls qw( :numa :mman :sched );
+
+for my $t (
+    sub {
+        my ($mode, @nodes) = get_mempolicy;
+        defined $mode or die "get_mempolicy failed; $!";
+        my $pid = fork // die "Can't fork; $!";
+        if (!$pid) {
+            my $bound = numa_bind_local() // POSIX::_exit(1);
+            my ($mode, @nodes) = get_mempolicy;
+            POSIX::_exit( $mode == MPOL_BIND && "@nodes" eq $bound ? 0 : 2 );
+        }
+        waitpid $pid, 0;
+        $? == 0 or die "numa_bind_local failed in child (".($? >> 8).")";
+    },
+    sub {
+        my $ps = POSIX::sysconf( POSIX::_SC_PAGESIZE() );
+        my $m = mmap undef, 2 * $ps, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS or die "mmap failed; $!";
+        mbind $m, MPOL_PREFERRED, [ 0 ] or die "mbind failed; $!";
+        $m->poke(0, 'x');
+        my @where = move_pages 0, [ $m->addr, $m->addr + $ps ];
+        @where == 2 or die "move_pages failed; $!";
+        $where[0] >= 0 or die "Expected touched page to be on a node, got $where[0]";
+        $where[1] == -POSIX::ENOENT() or die "Expected untouched page to be absent, got $where[1]";
+        my $node = get_mempolicy $m->addr, MPOL_F_NODE | MPOL_F_ADDR;
+        $node == $where[0] or die "get_mempolicy says node $node, move_pages says $where[0]";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,78 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use File::Temp qw( tempdir );
+use IO::Handle ();
+use POSIX ();
+
+use Linux::Syscalls qw( :cache :mman );
+
+my $dir = tempdir CLEANUP => 1;
+
+my $page = POSIX::sysconf(POSIX::_SC_PAGESIZE()) || 4096;
+
+# Four whole pages and a partial fifth, written and fsynced, so all of it
+# should be in the page cache (and none of it dirty).
+my $pages = 5;
+open my $fh, '+>:raw', "$dir/data" or die "Can't create $dir/data; $!";
+syswrite $fh, 'x' x ( 4*$page + 100 ) or die "Can't write $dir/data; $!";
+$fh->sync or die "Can't fsync $dir/data; $!";
+
+for my $t (
+    sub {
+        exists &cache_residency or die "Missing &cache_residency";
+        posix_fadvise $fh, 0, 0, POSIX_FADV_WILLNEED or die "posix_fadvise failed; $!";
+    },
+    sub {
+        my $m = mmap_file $fh or die "mmap_file failed; $!";
+        my $vec = mincore $m or die "mincore failed; $!";
+        length $vec == $pages or die "mincore returned @{[ length $vec ]} entries, expected $pages";
+        $vec =~ /^[\x01\x03]*\z/ or die "Freshly written pages not resident";
+    },
+    sub {
+        sysseek $fh, 7, 0 or die "sysseek failed; $!";
+        my $cs = cache_residency $fh or die "cache_residency failed; $!";
+        sysseek( $fh, 0, 1 ) == 7 or die "cache_residency moved the file position";
+        $cs->nr_pages == $pages or die "nr_pages is @{[ $cs->nr_pages ]}, expected $pages";
+        $cs->nr_cache == $pages or die "nr_cache is @{[ $cs->nr_cache ]}, expected $pages";
+        $cs->fraction == 1 or die "fraction is @{[ $cs->fraction ]}, expected 1";
+    },
+    sub {
+        # Pretend cachestat is missing, as it would be before Linux v6.5
+        local $Linux::Syscalls::cache_residency_use_cachestat = 0;
+        my $cs = cache_residency $fh, $page, 0 or die "cache_residency failed; $!";
+        $cs->nr_pages == $pages - 1 or die "nr_pages is @{[ $cs->nr_pages ]}, expected @{[ $pages - 1 ]}";
+        $cs->nr_cache == $pages - 1 or die "nr_cache is @{[ $cs->nr_cache ]}, expected @{[ $pages - 1 ]}";
+        defined $cs->nr_dirty     and die "nr_dirty filled in by the mincore fallback";
+        defined $cs->nr_writeback and die "nr_writeback filled in by the mincore fallback";
+        defined $cs->nr_evicted   and die "nr_evicted filled in by the mincore fallback";
+    },
+    sub {
+        open my $empty, '+>:raw', "$dir/empty" or die "Can't create $dir/empty; $!";
+        for my $use_cachestat (1, 0) {
+            local $Linux::Syscalls::cache_residency_use_cachestat = $use_cachestat;
+            my $cs = cache_residency $empty or die "cache_residency failed; $!";
+            $cs->nr_pages == 0 or die "nr_pages is @{[ $cs->nr_pages ]} for an empty file";
+            defined $cs->fraction and die "fraction is @{[ $cs->fraction ]} for an empty file";
+        }
+    },
+    sub {
+        my $cs = cachestat $fh, 0, 0;
+        if ( ! $cs ) {
+            $! == POSIX::ENOSYS or die "cachestat failed; $!";
+            return;
+        }
+        $cs->nr_cache == $pages or die "nr_cache is @{[ $cs->nr_cache ]}, expected $pages";
+        $cs->nr_dirty == 0 or die "Pages still dirty after fsync";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,66 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use Linux::Syscalls qw( :epoll );
+use Time::Nanosecond qw( new_timespec );
+
+for my $t (
+    sub {
+        exists &epoll_pwait2 or die "Missing &epoll_pwait2";
+    },
+    sub {
+        my $ep = epoll_create1 EPOLL_CLOEXEC or die "epoll_create1 failed; $!";
+        pipe my $r, my $w or die "pipe failed; $!";
+        epoll_ctl $ep, EPOLL_CTL_ADD, $r, EPOLLIN or die "epoll_ctl(ADD) failed; $!";
+
+        my @ready = epoll_pwait2 $ep, 0;
+        !@ready && $! == 0 or die "Expected timeout, got (@ready); $!";
+
+        syswrite $w, 'x' or die "write failed; $!";
+        @ready = epoll_pwait2 $ep, new_timespec(1, 0);
+        "@ready" eq fileno($r).' '.EPOLLIN or die "Expected (".fileno($r).", ".EPOLLIN."), got (@ready); $!";
+
+        epoll_ctl $ep, EPOLL_CTL_MOD, $r, EPOLLIN, 0x12345678 or die "epoll_ctl(MOD) failed; $!";
+        @ready = epoll_pwait2 $ep, 0.5;
+        "@ready" eq 0x12345678.' '.EPOLLIN or die "Expected user data back, got (@ready)";
+
+        epoll_ctl $ep, EPOLL_CTL_DEL, $r or die "epoll_ctl(DEL) failed; $!";
+        @ready = epoll_pwait2 $ep, 0;
+        !@ready or die "Expected nothing after DEL, got (@ready)";
+        POSIX::close($ep);
+    },
+    sub {
+        my $ep = epoll_create1 or die "epoll_create1 failed; $!";
+        my @pipes = map { pipe my $r, my $w or die "pipe failed; $!"; [ $r, $w ] } 1 .. 10;
+        epoll_ctl $ep, EPOLL_CTL_ADD, $_->[0], EPOLLIN for @pipes;
+        syswrite $_->[1], 'x' for @pipes;
+        my %ready = epoll_pwait2 $ep, 0, 4;
+        keys %ready == 4 or die "Expected maxevents to limit results to 4, got ".keys %ready;
+        %ready = epoll_pwait2 $ep, 0;
+        keys %ready == 10 or die "Expected 10 ready, got ".keys %ready;
+        POSIX::close($ep);
+    },
+    sub {
+        my $ep = epoll_create1 or die "epoll_create1 failed; $!";
+        pipe my $r, my $w or die "pipe failed; $!";
+        close $r;
+        my @warnings;
+        local $SIG{__WARN__} = sub { push @warnings, @_ };
+        !epoll_ctl( $ep, EPOLL_CTL_ADD, $r, EPOLLIN ) && $!{EBADF} or die "Expected EBADF for a closed handle; $!";
+        !epoll_pwait2( $r, 0 ) && $!{EBADF} or die "Expected EBADF for a closed epoll handle; $!";
+        !@warnings or die "Unexpected warnings: @warnings";
+        my %ready = epoll_pwait2 $ep, 0;
+        !%ready or die "Closed handle was registered as fd (@{[ keys %ready ]})";
+        POSIX::close($ep);
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
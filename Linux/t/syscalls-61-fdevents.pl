@@ -0,0 +1,61 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use POSIX ();
+use Linux::Syscalls qw( :eventfd :timerfd :signalfd :poll );
+use Time::Nanosecond qw( new_timespec );
+
+for my $t (
+    sub {
+        my $efd = eventfd 0, EFD_CLOEXEC|EFD_NONBLOCK or die "eventfd failed; $!";
+        my @v = eventfd_read $efd;
+        !@v && $!{EAGAIN} or die "Expected EAGAIN from empty eventfd, got (@v); $!";
+        eventfd_write $efd, 3 or die "eventfd_write failed; $!";
+        eventfd_write $efd      or die "eventfd_write failed; $!";
+        my $n = eventfd_read $efd;
+        $n == 4 or die "Expected eventfd to sum to 4, got $n";
+        POSIX::close($efd);
+    },
+    sub {
+        my $tfd = timerfd_create CLOCK_MONOTONIC, TFD_CLOEXEC or die "timerfd_create failed; $!";
+        my @old = timerfd_settime $tfd, 0, new_timespec(0, 20_000_000), new_timespec(0, 5_000_000)
+            or die "timerfd_settime failed; $!";
+        $old[0] == 0 && $old[1] == 0 or die "Expected new timer to be disarmed, got (@old)";
+        my ($value, $interval) = timerfd_gettime $tfd or die "timerfd_gettime failed; $!";
+        $value > 0 && $value <= 0.02 or die "Unexpected remaining time $value";
+        abs( $interval - 0.005 ) < 1e-9 or die "Unexpected interval $interval";
+        my %ready = ppoll { $tfd => POLLIN }, 1;
+        $ready{$tfd} or die "Timer didn't fire";
+        my $n = timerfd_read $tfd;
+        $n >= 1 or die "Expected at least one expiration, got $n";
+        timerfd_settime $tfd, 0, 0 or die "timerfd_settime (disarm) failed; $!";
+        ($value) = timerfd_gettime $tfd;
+        $value == 0 or die "Expected disarmed timer, got $value";
+        POSIX::close($tfd);
+    },
+    sub {
+        my $old = POSIX::SigSet->new;
+        my $set = POSIX::SigSet->new( POSIX::SIGUSR1(), POSIX::SIGUSR2() );
+        POSIX::sigprocmask( POSIX::SIG_BLOCK(), $set, $old ) or die "sigprocmask failed; $!";
+        my $sfd = signalfd undef, [ 'USR1', 'SIGUSR2' ], SFD_CLOEXEC|SFD_NONBLOCK or die "signalfd failed; $!";
+        kill USR1 => $$;
+        kill USR2 => $$;
+        my @si = signalfd_read $sfd;
+        POSIX::sigprocmask( POSIX::SIG_SETMASK(), $old );
+        POSIX::close($sfd);
+        my @got = sort { $a <=> $b } map { $_->signo } @si;
+        "@got" eq join( ' ', sort { $a <=> $b } POSIX::SIGUSR1(), POSIX::SIGUSR2() )
+            or die "Expected USR1 & USR2, got (@got)";
+        $_->pid == $$ or die "Expected signal from $$, got ".$_->pid for @si;
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,55 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use POSIX ();
+use Time::Nanosecond ();
+use Linux::Syscalls qw( :clock :time_ );
+
+for my $t (
+    sub {
+        for my $clock ( CLOCK_REALTIME, CLOCK_MONOTONIC, CLOCK_MONOTONIC_RAW, CLOCK_BOOTTIME, CLOCK_TAI,
+                        CLOCK_PROCESS_CPUTIME_ID, CLOCK_THREAD_CPUTIME_ID, clock_getcpuclockid($$) ) {
+            my $a = clock_gettime $clock or die "clock_gettime($clock) failed; $!";
+            my $b = clock_gettime $clock;
+            $a->isa('Time::Nanosecond::ts') or die "Expected Time::Nanosecond::ts from clock $clock";
+            $b >= $a or die "Clock $clock went backwards";
+            my $res = clock_getres $clock or die "clock_getres($clock) failed; $!";
+            $res > 0 && $res < 1 or die "Implausible resolution $res for clock $clock";
+        }
+        my ($s, $ns) = @{ clock_gettime CLOCK_REALTIME, TIME_PAIR };
+        abs( $s - time ) <= 1 && $ns < 1_000_000_000 or die "Wrong realtime ($s, $ns)";
+        my @bad = clock_gettime 12345;
+        !@bad && $!{EINVAL} or die "Expected EINVAL for a bad clock";
+    },
+    sub {
+        my $start = clock_gettime CLOCK_MONOTONIC, TIME_NS;
+        clock_nanosleep CLOCK_MONOTONIC, 0, 0.02 or die "clock_nanosleep failed; $!";
+        my $deadline = Time::Nanosecond::ns9->from_nanoseconds( $start->nanoseconds + 50_000_000 );
+        clock_nanosleep CLOCK_MONOTONIC, TIMER_ABSTIME, $deadline or die "clock_nanosleep(TIMER_ABSTIME) failed; $!";
+        my $end = clock_gettime CLOCK_MONOTONIC, TIME_NS;
+        $end >= $deadline or die "Woke before the deadline";
+    },
+    sub {
+        my $tick = ticker 0.005 or die "ticker failed; $!";
+        my $first = $tick->next_ns;
+        my $n = 0;
+        $n += $tick->wait for 1 .. 10;
+        # Overrun by several periods
+        select undef, undef, undef, 0.03;
+        my $skipped = $tick->wait;
+        $skipped >= 6 or die "Expected to skip missed ticks, got $skipped";
+        $n += $skipped;
+        $tick->next_ns == $first + $n * 5_000_000 or die "Deadlines drifted";
+        $tick->missed == $n - 11 or die "Wrong missed count ".$tick->missed;
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
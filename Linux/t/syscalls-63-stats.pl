@@ -0,0 +1,40 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+# The counters are only compiled in if this is set when the module is loaded
+BEGIN { $ENV{PERL5_SYSCALL_STATS} = 1 }
+
+use POSIX ();
+use Linux::Syscalls qw( :stats :clock statns );
+
+for my $t (
+    sub {
+        syscall_stats_reset or die "syscall_stats_reset failed; $!";
+        statns '/' or die "statns failed; $!";
+        !statns '/nonexistent/file' && $!{ENOENT} or die "Expected ENOENT to survive counting; $!";
+        clock_gettime CLOCK_MONOTONIC for 1 .. 5;
+        my $st = syscall_stats or die "syscall_stats failed; $!";
+        $st->{stat}{calls} == 2 or die "Expected 2 stat calls, got $st->{stat}{calls}";
+        $st->{stat}{errors}{ENOENT} == 1 or die "Expected 1 ENOENT from stat";
+        $st->{clock_gettime}{calls} == 5 && !%{ $st->{clock_gettime}{errors} } or die "Wrong clock_gettime counts";
+        $st->{stat}{ns} > 0 or die "Missing stat time";
+        my $report = syscall_report;
+        $report =~ /^syscall\s+calls\s+errors/ or die "Missing report header";
+        $report =~ /^stat\s+2\s+1\s+\d+\s+\d+\s+ENOENT=1$/m or die "Wrong report row:\n$report";
+    },
+    sub {
+        local $ENV{PERL5_SYSCALL_STATS};
+        my $out = `$^X -e 'use Linux::Syscalls qw( :stats ); print syscall_stats ? "on" : "off ".(\$!+0)'`;
+        $out eq 'off '.POSIX::ENOSYS() or die "Expected counters to be compiled out, got '$out'";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
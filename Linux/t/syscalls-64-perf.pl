@@ -0,0 +1,46 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use POSIX ();
+use Linux::Syscalls qw( :perf );
+
+for my $t (
+    sub {
+        my $pc = perf_counters qw( task-clock page-faults context-switches cpu-migrations )
+            or die "perf_counters failed; $!";
+        my ($busy, $enabled, $running) = $pc->measure( sub { my $x = 'x' x 8_000_000; my $s = 0; $s += $_ for 1 .. 200_000 } )
+            or die "measure failed; $!";
+        "@{[ sort keys %$busy ]}" eq 'context-switches cpu-migrations page-faults task-clock' or die "Wrong names (@{[ keys %$busy ]})";
+        $busy->{'task-clock'} > 0 or die "Expected some task-clock";
+        $busy->{'page-faults'} > 0 or die "Expected touching 8MB to fault";
+        $enabled >= $busy->{'task-clock'} && $running == $enabled or die "Wrong times enabled $enabled, running $running";
+        my $idle = $pc->read;
+        $idle->{'task-clock'} == $busy->{'task-clock'} or die "Expected counters to stop when disabled";
+        $pc->reset or die "reset failed; $!";
+        $pc->read->{'page-faults'} == 0 or die "Expected reset to zero the group";
+    },
+    sub {
+        my $fd = perf_event_open { config => PERF_COUNT_SW_TASK_CLOCK, disabled => 1, exclude_kernel => 1,
+                                   read_format => PERF_FORMAT_ID }
+            or die "perf_event_open failed; $!";
+        my $r = perf_event_read $fd, PERF_FORMAT_ID or die "perf_event_read failed; $!";
+        $r->{value} == 0 or die "Expected disabled counter to be zero";
+        $r->{id} == perf_event_id $fd or die "Wrong id";
+        perf_event_enable $fd or die "perf_event_enable failed; $!";
+        my $s = 0; $s += $_ for 1 .. 100_000;
+        perf_event_disable $fd or die "perf_event_disable failed; $!";
+        perf_event_read( $fd, PERF_FORMAT_ID )->{value} > 0 or die "Expected enabled counter to count";
+        POSIX::close($fd);
+        !perf_event_open( { bogus => 1 } ) && $!{EINVAL} or die "Expected EINVAL for unknown attribute";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,63 @@
+#!/usr/bin/perl
+
+use 5.016;
+use strict;
+use warnings;
+
+my $num_errors = 0;
+
+use POSIX ();
+use File::Temp ();
+use Linux::Syscalls qw( :uring :O_ statns );
+
+for my $t (
+    sub {
+        my $u = uring 8 or die "uring failed; $!";
+        my %want = map { ( $u->nop => 1 ) } 1 .. 100;
+        my @c = $u->complete_all;
+        @c == 100 && !grep { !delete $want{ $_->{id} } } @c or die "Wrong completions for more nops than ring entries";
+        $u->pending == 0 or die "Expected nothing pending";
+    },
+    sub {
+        my $u = uring or die "uring failed; $!";
+        my %path_of = map { ( $u->statx( undef, $_ ) => $_ ) } '/', $0, '/nonexistent/file';
+        my @c = $u->complete_all;
+        @c == 3 or die "Expected 3 completions, got ".@c;
+        for my $c (@c) {
+            my $path = $path_of{ $c->{id} } or die "Unknown id $c->{id}";
+            if ( $path eq '/nonexistent/file' ) {
+                $c->{errno} == POSIX::ENOENT() && $c->{res} < 0 or die "Expected ENOENT for $path";
+                next;
+            }
+            my $st = statns $path or die "statns failed; $!";
+            $c->{value}->ino == $st->ino && $c->{value}->size == $st->size && $c->{value}->dev == $st->dev
+                or die "statx disagrees with statns for $path";
+        }
+    },
+    sub {
+        my $u = uring 16 or die "uring failed; $!";
+        my $dir = File::Temp::tempdir( CLEANUP => 1 );
+        my $open = $u->openat( undef, "$dir/f", O_RDWR | O_CREAT | O_EXCL, 0600 );
+        my ($c) = $u->complete or die "complete failed; $!";
+        $c->{id} == $open && $c->{op} eq 'openat' or die "Wrong completion";
+        my $fd = $c->{value} // die "openat failed; $c->{errno}";
+        $u->write( $fd, "world\n", 6 );
+        $u->write( $fd, 'hello ', 0 );
+        2 == grep { $_->{res} == 6 } $u->complete_all or die "Writes failed";
+        $u->read( $fd, 100, 0 );
+        ($c) = $u->complete;
+        $c->{value} eq "hello world\n" or die "Read back '$c->{value}'";
+        $u->close($fd);
+        ($c) = $u->complete;
+        $c->{res} == 0 or die "close failed; $c->{errno}";
+        opendir my $dh, $dir or die "opendir failed; $!";
+        $u->getdents($dh);
+        ($c) = $u->complete;
+        grep { $_->name eq 'f' } @{ $c->{value} } or die "getdents didn't find the file";
+    },
+) {
+    eval { $t->(); 1 } or do { ++$num_errors; warn $@ }
+
+}
+
+exit $num_errors == 0 ? 0 : 1;
@@ -0,0 +1,115 @@
+#include <sys/types.h>
+#include <linux/io_uring.h>
+
+#include <stddef.h>     /* offsetof */
+#include <stdint.h>     /* intmax_t */
+#include <stdio.h>      /* printf, stdout, stderr */
+#include <string.h>
+
+#undef  PENV_WANT_STAT
+#undef  PENV_WANT_LARGEFILE
+#undef  PENV_WANT_STAT_VER
+
+#include "show_struct.h"
+
+////////////////////////////////////////
+
+void Pio_uring_sqe(void) {
+    puts("");
+   #define T struct io_uring_sqe
+    Begin();
+    F(opcode);          /* type of operation for this sqe */
+    F(flags);           /* IOSQE_ flags */
+    F(ioprio);          /* ioprio for the request */
+    F(fd);              /* file descriptor to do IO on */
+    F(off);             /* offset into file (or addr2) */
+    F(addr);            /* pointer to buffer or iovecs */
+    F(len);             /* buffer size or number of iovecs */
+    F(rw_flags);        /* (or open_flags, statx_flags, ...) */
+    F(user_data);       /* data to be passed back at completion time */
+    F(buf_index);       /* index into fixed buffers, if used */
+    F(personality);     /* personality to use, if used */
+    F(splice_fd_in);    /* (or file_index) */
+    F(addr3);
+    FA(__pad2);
+    End();
+   #undef T
+}
+
+void Pio_uring_cqe(void) {
+    puts("");
+   #define T struct io_uring_cqe
+    Begin();
+    F(user_data);       /* sqe->data submission passed back */
+    F(res);             /* result code for this event */
+    F(flags);
+    End();
+   #undef T
+}
+
+void Pio_sqring_offsets(void) {
+    puts("");
+   #define T struct io_sqring_offsets
+    Begin();
+    F(head);
+    F(tail);
+    F(ring_mask);
+    F(ring_entries);
+    F(flags);
+    F(dropped);
+    F(array);
+    F(resv1);
+    F(resv2);
+    End();
+   #undef T
+}
+
+void Pio_cqring_offsets(void) {
+    puts("");
+   #define T struct io_cqring_offsets
+    Begin();
+    F(head);
+    F(tail);
+    F(ring_mask);
+    F(ring_entries);
+    F(overflow);
+    F(cqes);
+    F(flags);
+    F(resv1);
+    F(resv2);
+    End();
+   #undef T
+}
+
+void Pio_uring_params(void) {
+    puts("");
+   #define T struct io_uring_params
+    Begin();
+    F(sq_entries);
+    F(cq_entries);
+    F(flags);
+    F(sq_thread_cpu);
+    F(sq_thread_idle);
+    F(features);
+    F(wq_fd);
+    FA(resv);
+    Fblob(sq_off);      /* struct io_sqring_offsets, above */
+    Fblob(cq_off);      /* struct io_cqring_offsets, above */
+    End();
+   #undef T
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+int main() {
+    setvbuf(stdout, NULL, _IONBF, 0);
+    setvbuf(stderr, NULL, _IONBF, 0);
+
+    Pio_uring_sqe();
+    Pio_uring_cqe();
+    Pio_sqring_offsets();
+    Pio_cqring_offsets();
+    Pio_uring_params();
+
+    return 0;
+}
@@ -288,12 +288,14 @@ SCOPE  inline void EndStruct(TK *tr) {
         sxprintf(tr->packfmt, "%s", pfmt);
     }
     printf("%6zu }\n", tr->struct_size);
+    /* extra_perl is still unallocated (NULL) if no field needed any */
+    char const * extra = sxpeek(tr->extra_perl);
     printf("BEGIN PERL:\n\nmy (%s) = unpack\n            '%s',\n            $in; \t# %s (%zu bytes)\n%s\n",
             sxpeek(tr->fieldnames),
             sxpeek(tr->packfmt),
             tr->struct_name,
             (size_t) tr->struct_size,
-            sxpeek(tr->extra_perl));
+            extra ? extra : "");
     char const * env = Pbuildenv("\n#   ");
     if (env) {
         printf("# Build Env:%s\n", env);
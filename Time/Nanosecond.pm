@@ -135,8 +135,20 @@ package Time::Nanosecond::ts {
         return _normalize bless [ @_ ], $class;
     }
 
+    # Classes known to be (or not to be) derived from this one, so that the
+    # common case of ts±ts can skip the method calls and _normalize.
+    # (Sub calls are expensive, so the hash is also consulted inline.)
+    my %is_ts = ( '' => '', map { ( "Time::Nanosecond::$_" => 1 ) } qw( ts ts0 ts1 ts2 ts3 ts6 ts9 ) );
+    sub _is_ts($) { return $is_ts{ ref $_[0] } //= $_[0]->isa(__PACKAGE__) }
+
     sub add {
         my ($t, $u) = @_;
+        if ( $is_ts{ ref $u } // _is_ts $u ) {
+            my $s = $t->[0] + $u->[0];
+            my $ns = $t->[1] + $u->[1];
+            if ($ns >= 1E9) { ++$s; $ns -= 1E9 }
+            return bless [ $s, $ns ], ref $t;
+        }
         my @t = @$t;
         $u = ref($t)->from_fseconds($u) if ! ref $u;
         $t[0] += $u->_sec;
@@ -146,6 +158,13 @@ package Time::Nanosecond::ts {
 
     sub subtract {
         my ($t, $u, $swap) = @_;
+        if ( $is_ts{ ref $u } // _is_ts $u ) {
+            my ($x, $y) = $swap ? ($u, $t) : ($t, $u);
+            my $s = $x->[0] - $y->[0];
+            my $ns = $x->[1] - $y->[1];
+            if ($ns < 0) { --$s; $ns += 1E9 }
+            return bless [ $s, $ns ], ref $t;
+        }
         my @t = @$t;
         $u = ref($t)->from_fseconds($u) if ! ref $u;
         $t[0] -= $u->_sec;
@@ -162,14 +181,74 @@ package Time::Nanosecond::ts {
         return _normalize bless [ map { -$_ } @$t ], ref $t;
     }
 
+    # In-place operations, which don't allocate a new object.
+    #
+    # These are also used for the assignment operators; Perl calls the copy
+    # constructor first whenever the object is shared, so "$t += $u" still
+    # has value semantics.
+
+    sub add_ns($$) {
+        my ($t, $ns) = @_;
+        $t->[1] += $ns;
+        _normalize $t if $t->[1] < 0 || $t->[1] >= 1E9;
+        return $t;
+    }
+
+    sub subtract_into($$$) {
+        my ($r, $t, $u) = @_;
+        if ( ( $is_ts{ ref $t } // _is_ts $t ) && ( $is_ts{ ref $u } // _is_ts $u ) ) {
+            $r->[0] = $t->[0] - $u->[0];
+            $r->[1] = $t->[1] - $u->[1];
+            if ($r->[1] < 0) { --$r->[0]; $r->[1] += 1E9 }
+            return $r;
+        }
+        @$r = ( $t->_sec - $u->_sec, $t->_nsec - $u->_nsec );
+        return _normalize $r;
+    }
+
+    sub _add_in_place {
+        my ($t, $u) = @_;
+        $u = ref($t)->from_fseconds($u) if ! ref $u;
+        if ( $is_ts{ ref $u } // _is_ts $u ) {
+            $t->[0] += $u->[0];
+            $t->[1] += $u->[1];
+        } else {
+            $t->[0] += $u->_sec;
+            $t->[1] += $u->_nsec;
+        }
+        if ($t->[1] >= 1E9) { ++$t->[0]; $t->[1] -= 1E9 }
+        return $t;
+    }
+
+    sub _subtract_in_place {
+        my ($t, $u) = @_;
+        $u = ref($t)->from_fseconds($u) if ! ref $u;
+        if ( $is_ts{ ref $u } // _is_ts $u ) {
+            $t->[0] -= $u->[0];
+            $t->[1] -= $u->[1];
+        } else {
+            $t->[0] -= $u->_sec;
+            $t->[1] -= $u->_nsec;
+        }
+        if ($t->[1] < 0) { --$t->[0]; $t->[1] += 1E9 }
+        return $t;
+    }
+
     use overload
         '+'     => \&add,
         '-'     => \&subtract,
         'neg'   => \&negate,
+        '+='    => \&_add_in_place,
+        '-='    => \&_subtract_in_place,
         ;
 
     sub compare {
         my ($t, $u, $swap) = @_;
+        if ( $is_ts{ ref $u } // _is_ts $u ) {
+            my $r = $t->[0] <=> $u->[0]
+                 || $t->[1] <=> $u->[1];
+            return $swap ? -$r : $r;
+        }
         $u = ref($t)->from_fseconds($u) if ! ref $u;
         my $r;
         if (blessed $u && $u->can('_nsec')) {
@@ -204,7 +283,7 @@ package Time::Nanosecond::ts {
 
     use overload
         'bool'  => \&boolify,
-        '0+'    => \&seconds,   # use base method
+        '0+'    => 'seconds',   # use base method
         'int'   => \&_sec,
         ;
 
@@ -252,6 +331,7 @@ BEGIN { if (0x80000000 << 31 || $^C) { eval q{
 package Time::Nanosecond::ns {
     # Represent a time as an integer number of nanoseconds
 
+    BEGIN { $INC{'Time/Nanosecond/ns.pm'} = __FILE__ }
     use parent -norequire => Time::Nanosecond::base::;
 
     use POSIX qw(floor);
@@ -316,15 +396,24 @@ package Time::Nanosecond::ns {
         return $$t / 1E3;
     }
 
+    # As for ts, so that ns±ns can skip the method calls.
+    my %is_ns = ( '' => '', map { ( "Time::Nanosecond::$_" => 1 ) } qw( ns ns0 ns1 ns2 ns3 ns6 ns9 ) );
+    sub _is_ns($) { return $is_ns{ ref $_[0] } //= $_[0]->isa(__PACKAGE__) }
+
+    sub _ns_of($) {
+        my ($u) = @_;
+        return ( $is_ns{ ref $u } // _is_ns $u ) ? $$u : ref $u ? $u->nanoseconds : do { no integer; $u * 1E9 };
+    }
+
     sub add {
         my ($t, $u) = @_;
-        my $r = $$t + ( ref $u ? $u->nanoseconds : do { no integer; $u * 1E9 } );
+        my $r = $$t + ( ( $is_ns{ ref $u } // _is_ns $u ) ? $$u : _ns_of $u );
         return bless \$r, ref $t;
     }
 
     sub subtract {
         my ($t, $u, $swap) = @_;
-        my $r = $$t - ( ref $u ? $u->nanoseconds : do { no integer; $u * 1E9 } );
+        my $r = $$t - ( ( $is_ns{ ref $u } // _is_ns $u ) ? $$u : _ns_of $u );
         $r = -$r if $swap;
         return bless \$r, ref $t;
     }
@@ -335,15 +424,44 @@ package Time::Nanosecond::ns {
         return bless \$r, ref $t;
     }
 
+    # In-place operations; see Time::Nanosecond::ts
+
+    sub add_ns($$) {
+        my ($t, $ns) = @_;
+        $$t += $ns;
+        return $t;
+    }
+
+    sub subtract_into($$$) {
+        my ($r, $t, $u) = @_;
+        $$r = ( ( $is_ns{ ref $t } // _is_ns $t ) ? $$t : _ns_of $t )
+            - ( ( $is_ns{ ref $u } // _is_ns $u ) ? $$u : _ns_of $u );
+        return $r;
+    }
+
+    sub _add_in_place {
+        my ($t, $u) = @_;
+        $$t += ( $is_ns{ ref $u } // _is_ns $u ) ? $$u : _ns_of $u;
+        return $t;
+    }
+
+    sub _subtract_in_place {
+        my ($t, $u) = @_;
+        $$t -= ( $is_ns{ ref $u } // _is_ns $u ) ? $$u : _ns_of $u;
+        return $t;
+    }
+
     use overload
         '+'     => \&add,
         '-'     => \&subtract,
         'neg'   => \&negate,
+        '+='    => \&_add_in_place,
+        '-='    => \&_subtract_in_place,
         ;
 
     sub compare {
         my ($t, $u, $swap) = @_;
-        my $r = $$t <=> ( ref $u ? $u->nanoseconds : do { no integer; $u * 1E9 } );
+        my $r = $$t <=> ( ( $is_ns{ ref $u } // _is_ns $u ) ? $$u : _ns_of $u );
         $r = -$r if $swap;
         return $r;
     }
@@ -409,6 +527,312 @@ package Time::Nanosecond::ns0 {
     use parent Time::Nanosecond::ns::;
     use constant _prec => 0;
 }
+
+package Time::Nanosecond::array {
+    # A packed array of integer nanoseconds (native int64), for holding large
+    # numbers of timestamps or durations: 8 bytes each, rather than the hundred
+    # or so taken by each Time::Nanosecond::ts or ::ns. Nothing here creates an
+    # object per element; bulk operations unpack at most _chunk elements at a
+    # time, and single results are returned as Time::Nanosecond::ns9.
+    #
+    # Internally [ packed string, known-to-be-sorted flag ].
+
+    use POSIX qw(ceil);
+
+    use constant _chunk => 0x10000;
+
+    sub _ns($) { return ref $_[0] ? $_[0]->nanoseconds : $_[0] }
+
+    # delegated constructor
+    sub from_nanoseconds {
+        my $class = shift;
+        return bless [ pack('q*', @_), @_ < 2 ], $class;
+    }
+
+    # delegated constructor; takes ownership of a string packed with 'q*'
+    sub from_packed($) {
+        my ($class, $packed) = @_;
+        return bless [ $packed, length $packed <= 8 ], $class;
+    }
+
+    # delegated constructor; converts a buffer holding consecutive struct
+    # timespec, by default 'q2' (as on 64-bit Linux); use 'l2' for 32-bit.
+    sub from_timespecs($;$) {
+        my ($class, $buffer, $fmt) = @_;
+        $fmt //= 'q2';
+        my $rec = length pack $fmt, 0, 0;
+        my $n = length($buffer) / $rec;
+        my $packed = '';
+        for ( my $i = 0 ; $i < $n ; $i += _chunk ) {
+            my $k = $n - $i < _chunk ? $n - $i : _chunk;
+            my @ts = unpack "($fmt)$k", substr $buffer, $i * $rec, $k * $rec;
+            $packed .= pack 'q*', map { $ts[2*$_] * 1_000_000_000 + $ts[2*$_+1] } 0 .. $k-1;
+        }
+        return $class->from_packed($packed);
+    }
+
+    sub count($)  { return length( $_[0]->[0] ) / 8 }
+    sub packed($) { return $_[0]->[0] }
+    sub values($) { return unpack 'q*', $_[0]->[0] }
+
+    # Element $i as integer nanoseconds; negative $i counts from the end
+    sub nanoseconds($$) {
+        my ($arr, $i) = @_;
+        $i += $arr->count if $i < 0;
+        return if $i < 0 || $i >= $arr->count;
+        return unpack 'q', substr $arr->[0], $i * 8, 8;
+    }
+
+    sub get($$) {
+        my $ns = &nanoseconds // return;
+        return Time::Nanosecond::ns9->from_nanoseconds($ns);
+    }
+
+    sub push {
+        my ($arr, @t) = @_;
+        $arr->[0] .= pack 'q*', map { _ns $_ } @t;
+        $arr->[1] = $arr->count < 2 if @t;
+        return $arr;
+    }
+
+    sub append($$) {
+        my ($arr, $other) = @_;
+        $arr->[0] .= $other->[0];
+        $arr->[1] = $arr->count < 2 if length $other->[0];
+        return $arr;
+    }
+
+    # Calls $code->(@values) for each chunk in turn; $overlap repeats that many
+    # trailing elements of each chunk at the start of the next.
+    sub _each_chunk($$;$) {
+        my ($arr, $code, $overlap) = @_;
+        my $n = $arr->count;
+        for ( my $i = 0 ; $i < $n ; $i += _chunk ) {
+            my $off = $i < ($overlap // 0) ? 0 : $i - ($overlap // 0);
+            my $end = $i + _chunk < $n ? $i + _chunk : $n;
+            $code->( unpack 'q*', substr $arr->[0], $off * 8, ($end - $off) * 8 );
+        }
+    }
+
+    # Sorts in place, ascending
+    sub sort($) {
+        my ($arr) = @_;
+        $arr->[0] = pack 'q*', sort { $a <=> $b } unpack 'q*', $arr->[0] if ! $arr->[1];
+        $arr->[1] = 1;
+        return $arr;
+    }
+
+    sub is_sorted($) { return $_[0]->[1] }
+
+    # (List::Util::min & max compare as floating point, so they lose precision)
+    sub min($) {
+        my ($arr) = @_;
+        return $arr->get(0) if $arr->[1];
+        my $m;
+        $arr->_each_chunk( sub { $m //= $_[0]; $_ < $m and $m = $_ for @_ } );
+        return defined $m ? Time::Nanosecond::ns9->from_nanoseconds($m) : undef;
+    }
+
+    sub max($) {
+        my ($arr) = @_;
+        return $arr->get(-1) if $arr->[1];
+        my $m;
+        $arr->_each_chunk( sub { $m //= $_[0]; $_ > $m and $m = $_ for @_ } );
+        return defined $m ? Time::Nanosecond::ns9->from_nanoseconds($m) : undef;
+    }
+
+    # Index of the first element that is not less than $t (so count if there
+    # is none); sorts first if necessary.
+    sub search($$) {
+        my ($arr, $t) = @_;
+        $t = _ns $t;
+        $arr->sort;
+        my ($lo, $hi) = (0, $arr->count);
+        while ($lo < $hi) {
+            my $mid = ($lo + $hi) / 2;
+            if ( unpack('q', substr $arr->[0], $mid * 8, 8) < $t ) {
+                $lo = $mid + 1;
+            } else {
+                $hi = $mid;
+            }
+        }
+        return $lo;
+    }
+
+    # A new array holding the n-1 differences between consecutive elements
+    sub deltas($) {
+        my ($arr) = @_;
+        my $packed = '';
+        $arr->_each_chunk( sub { $packed .= pack 'q*', map { $_[$_] - $_[$_-1] } 1 .. $#_ }, 1 );
+        return ref($arr)->from_packed($packed);
+    }
+
+    # Nearest-rank percentiles (0 < $p <= 100); sorts first if necessary.
+    sub percentile($@) {
+        my ($arr, @p) = @_;
+        my $n = $arr->count or return;
+        $arr->sort;
+        my @r = map {
+            my $rank = do { no integer; ceil( $_ / 100 * $n ) };
+            $rank = 1  if $rank < 1;
+            $rank = $n if $rank > $n;
+            $arr->get($rank - 1);
+        } @p;
+        return wantarray ? @r : $r[0];
+    }
+}
+
+package Time::Nanosecond::histogram {
+    # A log-linear ("HDR") histogram of integer nanoseconds, for recording
+    # latencies without keeping every sample.
+    #
+    # Values below 2**$bits each have their own bucket; above that, each power
+    # of two is split into 2**($bits-1) equal buckets, so a value is known to
+    # within 1 part in 2**($bits-1) (0.8% with the default of 8 bits), and all
+    # of 1ns to 292 years needs at most a few thousand buckets. Recording is a
+    # handful of integer operations, and histograms with the same $bits can be
+    # merged, for example after passing them between processes with packed &
+    # from_packed.
+    #
+    # Internally [ $bits, \@counts, $count, $sum, $min, $max, 2**$bits ];
+    # $min & $max are only meaningful once $count is non-zero.
+
+    use constant _no_min => do { no integer; ~0 >> 1 };
+
+    # delegated constructor
+    sub new {
+        my ($class, $bits) = @_;
+        $bits //= 8;
+        $bits >= 1 && $bits <= 16 or die "Histogram precision must be 1..16 bits\n";
+        return bless [ $bits, [], 0, 0, _no_min, -1, 1 << $bits ], $class;
+    }
+
+    sub _index($$) {
+        my ($bits, $v) = @_;
+        return $v if $v < 1 << $bits;
+        my $e = length( sprintf '%b', $v ) - $bits;
+        return ( $e << ($bits - 1) ) + ( $v >> $e );
+    }
+
+    # Lowest & highest values that map to bucket $i
+    sub _bucket_range($$) {
+        my ($bits, $i) = @_;
+        return $i, $i if $i < 1 << $bits;
+        my $e = ( $i >> ($bits - 1) ) - 1;
+        my $lo = ( $i - ( $e << ($bits - 1) ) ) << $e;
+        return $lo, $lo + ( 1 << $e ) - 1;
+    }
+
+    # Takes integer nanoseconds or a Time::Nanosecond value; negative values
+    # are counted as 0. An optional $n records the same value $n times.
+    sub record {
+        my ($h, $v, $n) = @_;
+        $v = $v->nanoseconds if ref $v;
+        $v = 0 if $v < 0;
+        $n //= 1;
+        $h->[1][ $v < $h->[6] ? $v : _index $h->[0], $v ] += $n;
+        $h->[2] += $n;
+        $h->[3] += $v * $n;
+        $h->[4] = $v if $v < $h->[4];
+        $h->[5] = $v if $v > $h->[5];
+        return $h;
+    }
+
+    sub merge {
+        my ($h, @others) = @_;
+        for my $o (@others) {
+            $o->[0] == $h->[0] or die "Can't merge histograms with different precision\n";
+            my $c = $o->[1];
+            $c->[$_] and $h->[1][$_] += $c->[$_] for 0 .. $#$c;
+            $h->[2] += $o->[2];
+            $h->[3] += $o->[3];
+            $h->[4] = $o->[4] if $o->[4] < $h->[4];
+            $h->[5] = $o->[5] if $o->[5] > $h->[5];
+        }
+        return $h;
+    }
+
+    # Serialization: a header, then (bucket-gap, count) for each non-empty
+    # bucket, as BER integers.
+    use constant _magic => 'TNh1';
+
+    sub packed($) {
+        my ($h) = @_;
+        my $c = $h->[1];
+        my ($prev, @pairs) = (-1);
+        for my $i (0 .. $#$c) {
+            $c->[$i] or next;
+            push @pairs, $i - $prev, $c->[$i];
+            $prev = $i;
+        }
+        return pack 'a4 C q q q q w*', _magic, @$h[0, 2 .. 5], @pairs;
+    }
+
+    # delegated constructor
+    sub from_packed($) {
+        my ($class, $packed) = @_;
+        my ($magic, $bits, $count, $sum, $min, $max, @pairs) = unpack 'a4 C q q q q w*', $packed;
+        $magic eq _magic or die "Not a packed Time::Nanosecond::histogram\n";
+        my $h = $class->new($bits);
+        @$h[2 .. 5] = ( $count, $sum, $min, $max );
+        my $i = -1;
+        while (@pairs) {
+            my ($gap, $n) = splice @pairs, 0, 2;
+            $h->[1][ $i += $gap ] = $n;
+        }
+        return $h;
+    }
+
+    sub count($) { return $_[0]->[2] }
+    sub sum($)   { return Time::Nanosecond::ns9->from_nanoseconds( $_[0]->[3] ) }
+    sub min($)   { return $_[0]->[2] ? Time::Nanosecond::ns9->from_nanoseconds( $_[0]->[4] ) : undef }
+    sub max($)   { return $_[0]->[2] ? Time::Nanosecond::ns9->from_nanoseconds( $_[0]->[5] ) : undef }
+
+    sub mean($) {
+        my ($h) = @_;
+        return if ! $h->[2];
+        return Time::Nanosecond::ns9->from_nanoseconds( $h->[3] / $h->[2] );
+    }
+
+    # Nearest-rank percentiles (0 < $p <= 100); each is the highest value in
+    # the bucket concerned, but never more than the largest value recorded.
+    sub percentile($@) {
+        my ($h, @p) = @_;
+        my $n = $h->[2] or return;
+        my ($bits, $c) = @$h;
+        my @rank = map {
+            my $r = do { no integer; POSIX::ceil( $_ / 100 * $n ) };
+            $r < 1 ? 1 : $r > $n ? $n : $r;
+        } @p;
+        my @order = sort { $rank[$a] <=> $rank[$b] } 0 .. $#rank;
+        my @r;
+        my ($i, $seen) = (-1, 0);
+        for my $k (@order) {
+            $seen += $c->[++$i] // 0 while $seen < $rank[$k];
+            my (undef, $hi) = _bucket_range $bits, $i;
+            $hi = $h->[5] if $hi > $h->[5];
+            $r[$k] = Time::Nanosecond::ns9->from_nanoseconds($hi);
+        }
+        return wantarray ? @r : $r[0];
+    }
+
+    # A one-line summary, with a header line if $header is true; values are
+    # rendered with strftime's precision rules for %.ρs (by default '%.6s').
+    use constant _report_percentiles => ( 50, 90, 99, 99.9 );
+
+    sub report {
+        my ($h, $fmt, $header) = @_;
+        my $f = Time::Nanosecond::strftime_compile( $fmt // '%.6s', 1 );
+        my @v = $h->[2] ? map { $f->($_) } $h->min, $h->percentile(_report_percentiles), $h->max, $h->mean
+                        : ('-') x 7;
+        my $w = 6;
+        $w < length and $w = length for @v;
+        my $row = '%10s' . " %${w}s" x 7 . "\n";
+        return ( $header ? sprintf $row, 'count', 'min', map( { "p$_" } _report_percentiles ), 'max', 'mean' : '' )
+             . sprintf $row, $h->[2], @v;
+    }
+}
+
 }}}
 
 package Time::Nanosecond::base {
@@ -616,8 +1040,9 @@ package Time::Nanosecond::base {
     # A Time::Nanosecond::ts has value semantics, not container semantics, so
     # mutating operators are very strongly discouraged.
     #
-    # We can rely on Perl to convert $t++ to $t += 1 to $t = $t+1, which
-    # we then interpret to produce a new instance.
+    # We can rely on Perl to convert $t++ to $t += 1, which ts and ns implement
+    # in place, having first called the copy constructor if the object is
+    # shared.
 
     #sub increment { $_[0]->[0]++ }
     #sub decrement { $_[0]->[0]-- }
@@ -707,6 +1132,74 @@ package Time::Nanosecond v0.1.1 {
     }
     push @EXPORT_OK, qw( new_nanoseconds );
 
+    # Takes any mix of Time::Nanosecond values and integer nanoseconds
+    sub new_array {
+        return Time::Nanosecond::array->from_nanoseconds( map { ref $_ ? $_->nanoseconds : $_ } @_ );
+    }
+    push @EXPORT_OK, qw( new_array );
+
+    sub new_histogram(;$) {
+        return Time::Nanosecond::histogram->new(@_);
+    }
+    push @EXPORT_OK, qw( new_histogram );
+
+    ################################################################################
+    #
+    # parse_iso8601 parses an ISO 8601 / RFC 3339 timestamp such as
+    #
+    #   2023-11-14T22:13:20.123456789Z
+    #   2023-11-14 22:13:20,5+10:00
+    #
+    # returning a Time::Nanosecond::ts (or ::ns, if the second argument is 'ns')
+    # whose precision matches the number of fractional digits given (rounded up
+    # to 3, 6 or 9 digits); digits beyond nanoseconds are truncated. A missing
+    # offset is taken as UTC. Returns empty if the string isn't recognized.
+    #
+    # The conversion from date to epoch-day is cached, so that for a run of
+    # timestamps on the same day only the time-of-day is parsed. Neither mktime
+    # nor floating point is involved.
+
+    # Days since 1970-01-01 in the proleptic Gregorian calendar
+    sub _epoch_day($$$) {
+        my ($y, $m, $d) = @_;
+        $y -= $m <= 2;
+        my $era = ($y >= 0 ? $y : $y - 399) / 400;
+        my $yoe = $y - $era * 400;
+        my $doy = (153 * ($m > 2 ? $m - 3 : $m + 9) + 2) / 5 + $d - 1;
+        my $doe = $yoe * 365 + $yoe / 4 - $yoe / 100 + $doy;
+        return $era * 146097 + $doe - 719468;
+    }
+
+    # Class for each number of fractional digits
+    my %iso8601_classes = map {
+        my $k = $_;
+        ( $k => [ map { "Time::Nanosecond::$k$_" } 0, 1, 2, 3, 6, 6, 6, 9, 9, 9 ] )
+    } qw( ts ns );
+    my %iso8601_day;
+
+    sub parse_iso8601($;$) {
+        my ($str, $kind) = @_;
+        my $classes = $iso8601_classes{ $kind // 'ts' } or die "Unknown kind '$kind'\n";
+        my $date = substr $str, 0, 10;
+        my $day = $iso8601_day{$date};
+        if ( ! defined $day ) {
+            $date =~ /^(\d{4})-(\d\d)-(\d\d)$/ && $2 >= 1 && $2 <= 12 && $3 >= 1 && $3 <= 31 or return;
+            %iso8601_day = () if keys %iso8601_day >= 4096;
+            $day = $iso8601_day{$date} = _epoch_day $1, $2, $3;
+        }
+
+        pos($str) = 10;
+        $str =~ m{ \G [Tt ] (\d\d) : (\d\d) : (\d\d) (?: [.,] (\d+) )?
+                   (?: [Zz] | ([-+]) (\d\d) :? (\d\d) )? \z }xg
+            && $1 <= 24 && $2 <= 59 && $3 <= 60 or return;
+        my $sec = $day * 86400 + $1 * 3600 + $2 * 60 + $3;
+        $sec -= ( $5 eq '-' ? -1 : 1 ) * ( $6 * 3600 + $7 * 60 ) if $5;
+        my $digits = length( $4 // '' );
+        my $ns = $digits ? 0 + substr $4.'00000000', 0, 9 : 0;
+        return $classes->[ $digits > 9 ? 9 : $digits ]->from_timespec( $sec, $ns );
+    }
+    push @EXPORT_OK, qw( parse_iso8601 );
+
     ################################################################################
     #
     # We extend Perl's version of strftime as follows:
@@ -878,6 +1371,133 @@ package Time::Nanosecond v0.1.1 {
     }
     push @EXPORT_OK, 'strftime';
 
+    ################################################################################
+    #
+    # strftime_compile parses a format once, returning a closure that formats a
+    # single time value (a Time::Nanosecond object, or plain epoch seconds):
+    #
+    #   my $fmt = strftime_compile '%F %.6T';       # or (..., 1) to use gmtime
+    #   print $fmt->($t), "\n" for @times;
+    #
+    # The output matches strftime (above), but the parts that only depend on the
+    # whole second are rendered once for each second (and timezone) and reused,
+    # so a run of timestamps within the same second only costs the fractional
+    # parts.
+    #
+    # A fractional conversion that has both a width and either the '-' flag or
+    # an unspecified precision varies in width from one value to the next, so
+    # formats that contain one are handed to strftime for each value instead.
+
+    sub _render_fraction($$$$) {
+        my ($ns, $prec, $dot, $flags) = @_;
+        my $np = substr sprintf('%09u', $ns), 0, $prec;
+        $np = ".$np" if $dot && $prec;
+        if ($flags =~ /-/) {
+            $np =~ s/0*$// and
+            $np =~ s/\.$//;
+        } elsif ($flags =~ /_/ && $np =~ s/\.?0*$//) {
+            $np = substr "$np         ", 0, $prec+$dot;
+        }
+        return $np;
+    }
+
+    sub strftime_compile($;$) {
+        my ($fmt, $gmt) = @_;
+        my @p = split qr{( %%
+                         | %[-^#_0]*\d*\.?\d*[EO]?\w
+                         )}x, $fmt;
+
+        # @static holds the whole-second parts between the fractional ones;
+        # each of @frac is [ $prec, $dot, $flags, $epoch_width ] where
+        # $epoch_width is only defined for %.s
+        my @static = ('');
+        my @frac;
+        my $slow;
+        for my $pp (@p) {
+            if ( not $pp =~ m<^%([-_#^0]*)(\d*)(?:(\.)(\d*))?([OE]?)([NrsST])$>x
+                 or not $3 || $6 eq 'N' ) {
+                $static[-1] .= $pp;
+                next;
+            }
+            my ($flags, $width, $dot, $prec, $mod, $conv) = ($1, $2, $3, $4, $5, $6);
+            $_ = ($_ // '') eq '' ? undef
+                                  : 0 + $_
+                for $width, $prec;
+            $dot = 0+!!$dot;
+            $prec = undef if defined $prec && $prec > 9;
+
+            my $epoch_width;
+            if ($conv eq 'N') {
+                $dot and undef $width;
+                $prec //= $width;
+                undef $width;
+            } elsif ($conv eq 's') {
+                $epoch_width = $width // 0;
+                undef $width;
+            }
+            if ($width) {
+                $slow = 1 if $flags =~ /-/ || !defined $prec;
+                $width -= length _render_fraction 0, $prec, $dot, $flags if ! $slow;
+                $width > 0 or $width = '';
+            }
+            $static[-1] .= '%'.$flags.($width // '').$mod.$conv if $conv ne 'N' && $conv ne 's';
+            push @frac, [ $prec, $dot, $flags, $epoch_width ];
+            push @static, '';
+        }
+
+        if ($slow) {
+            return sub {
+                my ($t) = @_;
+                return strftime( $fmt, $gmt ? Time::Nanosecond::gmtime($t) : Time::Nanosecond::localtime($t) );
+            };
+        }
+
+        my ($last_sec, $last_tz, @rendered, @tm);
+        return sub {
+            my ($t) = @_;
+            my ($sec, $ns, $dprec);
+            if (blessed $t) {
+                ($sec, $ns, $dprec) = ($t->_sec, $t->_nsec, $t->_prec);
+            } else {
+                no integer;
+                $sec = POSIX::floor($t);
+                $ns = int( ($t - $sec) * 1E9 + 0.5 );
+                $ns = 999_999_999 if $ns > 999_999_999;
+            }
+            $dprec //= 9;
+            my $tz = $ENV{TZ} // '';
+            if ( !defined $last_sec || $sec != $last_sec || $tz ne $last_tz ) {
+                @tm = $gmt ? CORE::gmtime $sec : CORE::localtime $sec;
+                @rendered = map { /%/ ? POSIX::strftime( $_, @tm ) : $_ } @static;
+                ($last_sec, $last_tz) = ($sec, $tz);
+            }
+            my $r = $rendered[0];
+            for my $i (0 .. $#frac) {
+                my ($prec, $dot, $flags, $epoch_width) = @{ $frac[$i] };
+                my $fns = $ns;
+                if (defined $epoch_width) {
+                    my $es = $sec;
+                    my $sign = '';
+                    if ($es < 0 && $fns) {
+                        $sign = '-';
+                        $epoch_width-- if $epoch_width;
+                        $es = -($es + 1);
+                        $fns = 1E9 - $fns;
+                    } elsif ($es < 0) {
+                        $sign = '-';
+                        $epoch_width-- if $epoch_width;
+                        $es = -$es;
+                    }
+                    $r .= sprintf '%s%0*d', $sign, $epoch_width, $es;
+                }
+                $r .= _render_fraction $fns, $prec // $dprec, $dot, $flags;
+                $r .= $rendered[$i+1];
+            }
+            return $r;
+        };
+    }
+    push @EXPORT_OK, 'strftime_compile';
+
     our %EXPORT_TAGS;
     $EXPORT_TAGS{everything} = \@EXPORT_OK;
 }
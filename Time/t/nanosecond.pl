@@ -8,7 +8,7 @@ my $num_errors = 0;
 
 use POSIX ();
 
-use Time::Nanosecond qw( new_timespec new_timeval localtime gmtime strftime );
+use Time::Nanosecond qw( new_timespec new_timeval new_array localtime gmtime strftime strftime_compile parse_iso8601 new_histogram );
 
 for my $t (
     sub {
@@ -23,6 +23,108 @@ for my $t (
         warn sprintf "Got s=%s n=%s\n", "$x", +$x;
         $x == 1E9 or die "Expected; 1E9"
     },
+    sub {
+        # Values that can't be distinguished as floating point
+        my $base = 1_700_000_000_000_000_000;
+        my @ns = map { $base + $_ * 7919 % 100_003 } 0 .. 199_999;
+        my $buf = pack '(q2)*', map { ( int($_ / 1_000_000_000), $_ % 1_000_000_000 ) } @ns;
+        my $arr = Time::Nanosecond::array->from_timespecs($buf);
+        $arr->count == @ns or die "Wrong count ".$arr->count;
+        $arr->nanoseconds(1) == $ns[1] && $arr->nanoseconds(-1) == $ns[-1] or die "Wrong elements";
+        my @sorted = sort { $a <=> $b } @ns;
+        $arr->min->nanoseconds == $sorted[0]  or die "Wrong min";
+        $arr->max->nanoseconds == $sorted[-1] or die "Wrong max";
+        $arr->is_sorted and die "Shouldn't be sorted yet";
+        $arr->sort->is_sorted or die "Should be sorted";
+        $arr->packed eq pack 'q*', @sorted or die "Wrong order";
+        my $i = $arr->search($base + 50_000);
+        $arr->nanoseconds($i) >= $base + 50_000 && $arr->nanoseconds($i-1) < $base + 50_000 or die "Wrong search result $i";
+        $arr->search($base + 200_000) == $arr->count or die "Expected search past the end";
+        my ($p50, $p99, $p100) = $arr->percentile(50, 99, 100);
+        $p50->nanoseconds == $sorted[99_999] && $p99->nanoseconds == $sorted[197_999] && $p100 == $arr->max
+            or die "Wrong percentiles";
+        my $d = $arr->deltas;
+        $d->count == @ns - 1 or die "Wrong delta count";
+        $d->nanoseconds(70_000) == $sorted[70_001] - $sorted[70_000] or die "Wrong delta across a chunk boundary";
+        $d->min->nanoseconds >= 0 or die "Expected non-negative deltas after sorting";
+    },
+    sub {
+        my $arr = new_array new_timespec(2, 5), 1_000_000_003, new_timespec(1, 4);
+        $arr->count == 3 && $arr->min->nanoseconds == 1_000_000_003 or die "Wrong mixed construction";
+        $arr->push(7)->append(new_array(9, 8));
+        join(' ', $arr->sort->values) eq '7 8 9 1000000003 1000000004 2000000005' or die "Wrong values ".join ' ', $arr->values;
+        $arr->get(3)->isa('Time::Nanosecond::ns') or die "Expected Time::Nanosecond::ns";
+    },
+    sub {
+        my @times = map { new_timespec( 1_700_000_000 + ($_ >> 2), $_ * 123_456_789 % 1_000_000_000 ) } 0 .. 11;
+        for my $tz ('UTC', 'Australia/Sydney') {
+            local $ENV{TZ} = $tz;
+            for my $fmt ('%F %.6T %z', '%s.%N', '%.3s', '%_.6S', '%-.6S', '%12.3S|', '%-12.3S|', '%%N %.N') {
+                my $c = strftime_compile $fmt;
+                for my $t (@times) {
+                    my ($got, $want) = ( $c->($t), strftime($fmt, localtime $t) );
+                    $got eq $want or die "strftime_compile '$fmt' in $tz gave '$got', expected '$want'";
+                }
+            }
+        }
+        my $c = strftime_compile '%T.%3N', 1;
+        $c->(86399.5) eq '23:59:59.500' && $c->(-0.25) eq '23:59:59.750' or die "Wrong result for plain seconds";
+    },
+    sub {
+        my $t = new_timespec(1, 900_000_000);
+        my $u = $t;
+        $t += new_timespec(0, 200_000_000);
+        "$t" eq '2.100000000' && "$u" eq '1.900000000' or die "Wrong += result ($t, $u)";
+        $t -= new_timespec(0, 200_000_001);
+        "$t" eq '1.899999999' or die "Wrong -= result $t";
+        my $d = new_timespec(0, 0);
+        $d->subtract_into( new_timespec(5, 1), new_timespec(2, 2) ) == $d or die "Expected subtract_into to return its invocant";
+        "$d" eq '2.999999999' or die "Wrong subtract_into result $d";
+        "@{[ new_timespec(1, 200) - new_timespec(3, 100) ]}" eq '-1.999999900' or die "Wrong negative difference";
+        $d->add_ns(-3_000_000_000);
+        "$d" eq '-0.000000001' or die "Wrong add_ns result $d";
+
+        my $n = Time::Nanosecond::ns9->from_nanoseconds(5);
+        my $m = $n;
+        $n += Time::Nanosecond::ns9->from_nanoseconds(10);
+        $n->add_ns(1);
+        $n->nanoseconds == 16 && $m->nanoseconds == 5 or die "Wrong ns in-place results";
+        $m->subtract_into( $n, new_timespec(0, 6) )->nanoseconds == 10 or die "Wrong ns subtract_into result";
+        ( new_timespec(1, 5) <=> new_timespec(1, 6) ) == -1 && ( $n <=> $m ) == 1 or die "Wrong comparisons";
+    },
+    sub {
+        my @v = map { int( 1000 * 1.001 ** $_ ) } 0 .. 9999;
+        my ($h, $g) = ( new_histogram, new_histogram );
+        $_ % 2 ? $h->record($_) : $g->record( Time::Nanosecond::ns9->from_nanoseconds($_) ) for @v;
+        $h->merge( Time::Nanosecond::histogram->from_packed( $g->packed ) );
+        my @sorted = sort { $a <=> $b } @v;
+        $h->count == @v && $h->min->nanoseconds == $sorted[0] && $h->max->nanoseconds == $sorted[-1]
+            or die "Wrong count, min or max";
+        my @p = $h->percentile(50, 99, 100);
+        $p[2]->nanoseconds == $sorted[-1] or die "Wrong p100";
+        for ( [ 0, 4_999 ], [ 1, 9_899 ] ) {
+            my ($k, $i) = @$_;
+            my $err = $p[$k]->nanoseconds - $sorted[$i];
+            $err >= 0 && $err <= $sorted[$i] / 128 or die "Percentile $k out by $err";
+        }
+        eval { $h->merge( new_histogram 4 ) } and die "Expected merging different precisions to fail";
+        my $report = $h->report('%.3s', 1);
+        $report =~ /^\s+count\s+min\s+p50\s+p90\s+p99\s+p99\.9\s+max\s+mean\n\s+10000\s+0\.000\s/ or die "Wrong report:\n$report";
+    },
+    sub {
+        my $t = parse_iso8601 '2023-11-14T22:13:20.123456789Z' or die "Failed to parse";
+        $t->_sec == 1_700_000_000 && $t->_nsec == 123_456_789 && $t->_prec == 9 or die "Wrong value $t";
+        $t = parse_iso8601 '2023-11-15 08:13:20,5+10:00' or die "Failed to parse with offset";
+        "$t" eq '1700000000.500000000' && $t->_prec == 1 or die "Wrong value $t with offset";
+        $t = parse_iso8601 '1969-12-31T23:59:59.75-0000', 'ns' or die "Failed to parse before epoch";
+        $t->isa('Time::Nanosecond::ns') && $t->nanoseconds == -250_000_000 or die "Wrong value $t before epoch";
+        for my $bad ('2023-13-01T00:00:00Z', '2023-11-14T22:61:00Z', '2023-11-14', 'yesterday') {
+            my @r = parse_iso8601 $bad;
+            @r and die "Expected '$bad' to be rejected";
+        }
+        ( parse_iso8601 '2000-02-29T00:00:00Z' )->_sec == 951_782_400 or die "Wrong leap day";
+        ( parse_iso8601 '1900-03-01T00:00:00Z' )->_sec == -2_203_891_200 or die "Wrong pre-1970 date";
+    },
 ) {
     eval { $t->(); } or do { ++$num_errors; warn $@ }
 
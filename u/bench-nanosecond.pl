@@ -0,0 +1,46 @@
+#!/usr/bin/perl
+#
+# Compare the cost of Time::Nanosecond arithmetic with plain integer maths.
+#
+#   PERL5LIB=. perl u/bench-nanosecond.pl [seconds-per-case]
+#
+
+use 5.016;
+use strict;
+use warnings;
+
+use Benchmark qw( countit );
+use Time::Nanosecond qw( new_timespec );
+
+my $secs = shift // 1;
+
+my ($i, $di) = ( 1_700_000_000_123_456_789, 1_000_001 );
+my ($ns, $dns) = map { Time::Nanosecond::ns9->from_nanoseconds($_) } $i, $di;
+my ($ts, $dts) = map { new_timespec( int($_ / 1E9), $_ % 1_000_000_000 ) } $i, $di;
+my ($end_ns, $end_ts) = ( $ns + $dns, $ts + $dts );
+my ($elapsed_ns, $elapsed_ts) = ( $ns->copy, $ts->copy );
+my $end_i = $i + $di;
+
+my @cases = (
+    'int + int'         => sub { my $r = $i + $di },
+    'int - int'         => sub { my $r = $end_i - $i },
+    'int += int'        => sub { $i += $di },
+    'ns + ns'           => sub { my $r = $ns + $dns },
+    'ns - ns'           => sub { my $r = $end_ns - $ns },
+    'ns <=> ns'         => sub { my $r = $end_ns <=> $ns },
+    'ns += ns'          => sub { $ns += $dns },
+    'ns->add_ns'        => sub { $ns->add_ns($di) },
+    'ns->subtract_into' => sub { $elapsed_ns->subtract_into($end_ns, $ns) },
+    'ts + ts'           => sub { my $r = $ts + $dts },
+    'ts - ts'           => sub { my $r = $end_ts - $ts },
+    'ts <=> ts'         => sub { my $r = $end_ts <=> $ts },
+    'ts += ts'          => sub { $ts += $dts },
+    'ts->add_ns'        => sub { $ts->add_ns($di) },
+    'ts->subtract_into' => sub { $elapsed_ts->subtract_into($end_ts, $ts) },
+);
+
+while ( my ($name, $code) = splice @cases, 0, 2 ) {
+    my $t = countit $secs, $code;
+    my $rate = $t->iters / ( $t->cpu_a || 1 );
+    printf "%-20s %12.0f/s %8.1f ns/op\n", $name, $rate, 1E9 / $rate;
+}